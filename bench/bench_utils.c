@@ -0,0 +1,47 @@
+/** @file
+ * Implementation of utilities used by benchmarks.
+ * Generator is splitmix64.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include "bench_utils.h"
+
+/** @brief Initiates generator.
+ * @param rng [out]        - pointer to generator,
+ * @param seed [in]        - seed.
+ */
+void initRng(rng_t *rng, uint64_t seed) {
+    rng->state = seed;
+}
+
+/** @brief Generates next number.
+ * @param rng [in,out]     - pointer to generator.
+ * @return Pseudorandom 64-bit number.
+ */
+uint64_t nextRng(rng_t *rng) {
+    uint64_t result = (rng->state += 0x9E3779B97F4A7C15ull);
+
+    result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+    result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+    return result ^ (result >> 31);
+}
+
+/** @brief Generates number from range.
+ * @param rng [in,out]     - pointer to generator,
+ * @param min [in]         - minimal number,
+ * @param max [in]         - maximal number.
+ * @return Pseudorandom number from @p min to @p max inclusive.
+ */
+uint64_t rangeRng(rng_t *rng, uint64_t min, uint64_t max) {
+    return min + nextRng(rng) % (max - min + 1);
+}
+
+/** @brief Generates number from unit interval.
+ * @param rng [in,out]     - pointer to generator.
+ * @return Pseudorandom number from 0 inclusive to 1 exclusive.
+ */
+double unitRng(rng_t *rng) {
+    return (double) (nextRng(rng) >> 11) / 9007199254740992.0;
+}
@@ -0,0 +1,30 @@
+/** @file
+ * Interface of utilities used by benchmarks.
+ * Contains seeded pseudorandom number generator, so every benchmark run
+ * with the same seed uses the same data.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_BENCH_UTILS_H
+#define ROADS_BENCH_UTILS_H
+
+#include <stdint.h>
+
+/**
+ * Structure representing state of pseudorandom number generator.
+ */
+typedef struct rng {
+    uint64_t state;             /**< State of generator. */
+} rng_t;
+
+void initRng(rng_t *rng, uint64_t seed);
+
+uint64_t nextRng(rng_t *rng);
+
+uint64_t rangeRng(rng_t *rng, uint64_t min, uint64_t max);
+
+double unitRng(rng_t *rng);
+
+#endif //ROADS_BENCH_UTILS_H
@@ -0,0 +1,236 @@
+/** @file
+ * Differential check of bulk loader.
+ * Builds pairs of random maps from the same roads: first map by calling
+ * addRoad for every road, second one by one call of addRoads. Both maps
+ * get the same roads added earlier one by one, then the same routes.
+ * Roads of block repeat pairs of cities in both orders and contain invalid
+ * parameters, years are drawn from small range, so there are many ties.
+ * Compares flags of added roads, oldest roads of map (which show order of
+ * cities of roads and numbers of cities), routes and their oldest roads.
+ * Prints number of mismatches, exits with code 1 if any result differs.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <getopt.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_utils.h"
+#include "map.h"
+#include "memory_stats.h"
+#include "roads_types.h"
+
+/**
+ * Macro defining maximal number of printed mismatches.
+ */
+#define MAX_PRINTED_MISMATCHES 10
+
+/**
+ * Macro defining length of city name.
+ */
+#define NAME_LENGTH 16
+
+/**
+ * Macro defining maximal number of cities of map.
+ */
+#define MAX_CITIES 40
+
+/**
+ * Macro defining maximal number of roads of block.
+ */
+#define MAX_BLOCK_ROADS 200
+
+/**
+ * Macro defining maximal number of roads added before block.
+ */
+#define MAX_EARLIER_ROADS 30
+
+/**
+ * Macro defining number of routes of map.
+ */
+#define ROUTES_NUM 10
+
+/**
+ * Names of cities, last one is invalid.
+ */
+static char names[MAX_CITIES + 1][NAME_LENGTH];
+
+/** @brief Prints error and exits program.
+ * @param message [in]     - error message.
+ */
+static void fail(const char *message) {
+    fprintf(stderr, "bulk_oracle: %s\n", message);
+    exit(1);
+}
+
+/** @brief Draws random road description.
+ * Every tenth road has invalid parameter.
+ * @param rng [in,out]     - pointer to generator,
+ * @param cities_num [in]  - number of cities,
+ * @param road [out]       - pointer to road description.
+ */
+static void drawRoad(rng_t *rng, unsigned cities_num, road_desc_t *road) {
+    static const int years[] = {1990, 2000, 2000, 2010};
+
+    road->city1 = names[rangeRng(rng, 0, cities_num - 1)];
+    road->city2 = names[rangeRng(rng, 0, cities_num - 1)];
+    road->length = (unsigned) rangeRng(rng, 1, 30);
+    road->year = years[rangeRng(rng, 0, 3)];
+
+    switch (rangeRng(rng, 0, 29)) {
+        case 0:
+            road->length = 0;
+            break;
+        case 1:
+            road->year = 0;
+            break;
+        case 2:
+            road->city2 = names[MAX_CITIES];
+            break;
+        default:
+            break;
+    }
+}
+
+/** @brief Compares results of both maps.
+ * Prints description of mismatch unless too many were printed.
+ * @param what [in]        - name of compared result,
+ * @param number [in]      - number of compared result,
+ * @param sequential [in]  - result of map built by addRoad or NULL,
+ * @param bulk [in]        - result of map built by addRoads or NULL,
+ * @param mismatches [in,out] - number of mismatches.
+ */
+static void compareResults(const char *what, unsigned number,
+                           const char *sequential, const char *bulk,
+                           unsigned long *mismatches) {
+    if (sequential == NULL || bulk == NULL)
+        fail("out of memory");
+    if (strcmp(sequential, bulk) == 0)
+        return;
+
+    if (*mismatches < MAX_PRINTED_MISMATCHES)
+        printf("mismatch %s %u\naddRoad:\n%s\naddRoads:\n%s\n", what, number,
+               sequential, bulk);
+    (*mismatches)++;
+}
+
+/** @brief Builds pair of maps and compares them.
+ * @param rng [in,out]     - pointer to generator,
+ * @param mismatches [in,out] - number of mismatches.
+ */
+static void checkMaps(rng_t *rng, unsigned long *mismatches) {
+    road_desc_t roads[MAX_BLOCK_ROADS];
+    bool added[MAX_BLOCK_ROADS];
+    unsigned cities_num = (unsigned) rangeRng(rng, 3, MAX_CITIES);
+    unsigned earlier_num = (unsigned) rangeRng(rng, 0, MAX_EARLIER_ROADS);
+    size_t roads_num = (size_t) rangeRng(rng, 0, MAX_BLOCK_ROADS);
+    Map *maps[2] = {newMap(), newMap()};
+    const char *results[2];
+
+    if (maps[0] == NULL || maps[1] == NULL)
+        fail("out of memory");
+
+    for (unsigned i = 0; i < earlier_num; i++) {
+        drawRoad(rng, cities_num, &roads[0]);
+        for (int m = 0; m < 2; m++)
+            addRoad(maps[m], roads[0].city1, roads[0].city2, roads[0].length,
+                    roads[0].year);
+    }
+
+    for (size_t i = 0; i < roads_num; i++)
+        drawRoad(rng, cities_num, &roads[i]);
+    if (!addRoads(maps[1], roads, roads_num, added))
+        fail("out of memory");
+    for (size_t i = 0; i < roads_num; i++) {
+        if (addRoad(maps[0], roads[i].city1, roads[i].city2, roads[i].length,
+                    roads[i].year) != added[i]) {
+            if (*mismatches < MAX_PRINTED_MISMATCHES)
+                printf("mismatch added %zu %s;%s\n", i, roads[i].city1,
+                       roads[i].city2);
+            (*mismatches)++;
+        }
+    }
+
+    for (unsigned id = 1; id <= ROUTES_NUM; id++) {
+        const char *city1 = names[rangeRng(rng, 0, cities_num - 1)];
+        const char *city2 = names[rangeRng(rng, 0, cities_num - 1)];
+
+        for (int m = 0; m < 2; m++)
+            newRoute(maps[m], id, city1, city2);
+        for (int m = 0; m < 2; m++)
+            results[m] = getRouteDescription(maps[m], id);
+        compareResults("getRouteDescription", id, results[0], results[1],
+                       mismatches);
+        for (int m = 0; m < 2; m++) {
+            MEMORY_FREE(MEMORY_ROUTE, (void *) results[m]);
+            results[m] = getOldestRouteRoad(maps[m], id);
+        }
+        compareResults("routeOldestRoad", id, results[0], results[1],
+                       mismatches);
+        for (int m = 0; m < 2; m++)
+            MEMORY_FREE(MEMORY_ROAD, (void *) results[m]);
+    }
+
+    for (int m = 0; m < 2; m++)
+        results[m] = getOldestRoads(maps[m], UINT_MAX);
+    compareResults("oldestRoads", UINT_MAX, results[0], results[1],
+                   mismatches);
+    for (int m = 0; m < 2; m++) {
+        MEMORY_FREE(MEMORY_ROAD, (void *) results[m]);
+        deleteMap(maps[m]);
+    }
+}
+
+/** @brief Prints usage of program.
+ * @param program [in]     - name of program.
+ */
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--seed N] [--maps N]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+            {"seed", required_argument, NULL, 's'},
+            {"maps", required_argument, NULL, 'm'},
+            {NULL, 0,                   NULL, 0}
+    };
+    uint64_t seed = 1;
+    unsigned maps = 1000;
+    unsigned long mismatches = 0;
+    rng_t rng;
+    int option;
+
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'm':
+                maps = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+            default:
+                printUsage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc || maps == 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    for (unsigned i = 0; i < MAX_CITIES; i++)
+        snprintf(names[i], NAME_LENGTH, "c%u", i);
+    strcpy(names[MAX_CITIES], "c;");
+
+    initRng(&rng, seed);
+    for (unsigned i = 0; i < maps; i++)
+        checkMaps(&rng, &mismatches);
+
+    printf("maps=%u mismatches=%lu\n", maps, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,525 @@
+/** @file
+ * Differential check of path engines.
+ * Builds random maps and runs the same path queries through reference
+ * engine (module path) and every alternative engine. Compares found paths,
+ * their length and year and verdicts of unambiguity. Paths are compared
+ * road by road only if reference verdict is unambiguous, because ambiguous
+ * path may be any of best paths. Queries mimic use in map module: new
+ * route, extending route (cities of route excluded) and removing road
+ * (cities of route excluded and direct road not allowed). Lengths and years
+ * are drawn from small ranges, so there are many ties. Small maps are
+ * generated many times, number of maps can be multiplied by option. Prints
+ * number of mismatches and speedup of every engine, exits with code 1 if
+ * any result differs.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <getopt.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "avl_map.h"
+#include "bench_utils.h"
+#include "command_stats.h"
+#include "list.h"
+#include "map.h"
+#include "path.h"
+#include "roads_types.h"
+#include "search.h"
+
+/**
+ * Macro defining maximal number of printed mismatches.
+ */
+#define MAX_PRINTED_MISMATCHES 10
+
+/**
+ * Macro defining length of city name.
+ */
+#define NAME_LENGTH 16
+
+/**
+ * Kind of query.
+ */
+typedef enum query_kind {
+    QUERY_NEW_ROUTE,            /**< Path without excluded cities. */
+    QUERY_EXTEND_ROUTE,         /**< Path avoiding cities of route. */
+    QUERY_REMOVE_ROAD,          /**< Diversion of road of route. */
+    QUERY_KINDS_NUM             /**< Number of kinds. */
+} query_kind_t;
+
+/**
+ * Names of kinds of queries.
+ */
+static const char *query_names[QUERY_KINDS_NUM] = {
+        "newRoute", "extendRoute", "removeRoad"
+};
+
+/**
+ * Structure representing path engine.
+ * Engine keeps its state between queries on one map.
+ */
+typedef struct path_engine {
+    const char *name;           /**< Name of engine. */
+    void *(*create)();          /**< Creates state of engine. */
+    void (*destroy)(void *);    /**< Deletes state of engine. */
+    path_t *(*find)(void *, Map *, City *, City *, list_t **, bool);
+                                /**< Finds best path. */
+    bool (*check)(void *, Map *, path_t *, City *, City *, list_t **, bool);
+                                /**< Checks if path is unambiguous. */
+} path_engine_t;
+
+/**
+ * Structure representing configuration of random maps.
+ */
+typedef struct map_config {
+    unsigned cities_num;        /**< Number of cities. */
+    unsigned roads_num;         /**< Number of added roads. */
+    unsigned max_length;        /**< Maximal length of road. */
+    unsigned years_num;         /**< Number of different years. */
+    unsigned maps;              /**< Number of maps. */
+} map_config_t;
+
+/**
+ * Structure representing result of query.
+ */
+typedef struct query_result {
+    path_t *path;               /**< Found path or NULL. */
+    bool unambiguous;           /**< Verdict of unambiguity. */
+} query_result_t;
+
+/**
+ * Structure representing totals of engine for one kind of queries.
+ */
+typedef struct engine_totals {
+    unsigned long queries;      /**< Number of queries. */
+    unsigned long found;        /**< Number of found paths. */
+    unsigned long unambiguous;  /**< Number of unambiguous paths. */
+    unsigned long mismatches;   /**< Number of results different than
+                                     reference. */
+    uint64_t time;              /**< Time of queries in nanoseconds. */
+} engine_totals_t;
+
+/**
+ * Configurations of random maps.
+ */
+static const map_config_t configs[] = {
+        {20,    40,     3,   3,  300},
+        {200,   500,    5,   5,  60},
+        {2000,  5000,   10,  10, 10},
+        {20000, 50000,  100, 50, 2}
+};
+
+/**
+ * Macro counting elements of array.
+ */
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+/** @brief Creates state of reference engine.
+ * @return Value NULL.
+ */
+static void *createReference() {
+    return NULL;
+}
+
+/** @brief Deletes state of reference engine.
+ * @param state [in]       - unused.
+ */
+static void destroyReference(void *state) {
+    (void) state;
+}
+
+/** @brief Finds path using @ref findBestPath.
+ * @param state [in]       - unused,
+ * @param map [in,out]     - pointer to map,
+ * @param city1 [in,out]   - pointer to first city,
+ * @param city2 [in,out]   - pointer to last city,
+ * @param exclude [in]     - list of excluded roads,
+ * @param direct [in]      - flag indicating if direct road can be used.
+ * @return Pointer to path or NULL.
+ */
+static path_t *findReference(void *state, Map *map, City *city1, City *city2,
+                             list_t **exclude, bool direct) {
+    (void) state;
+    return findBestPath(map, city1, city2, exclude, direct);
+}
+
+/** @brief Checks path using @ref checkIfPathDefinedUnambiguously.
+ * @param state [in]       - unused,
+ * @param map [in,out]     - pointer to map,
+ * @param path [in]        - pointer to path,
+ * @param city1 [in,out]   - pointer to first city,
+ * @param city2 [in,out]   - pointer to last city,
+ * @param exclude [in]     - list of excluded roads,
+ * @param direct [in]      - flag indicating if direct road can be used.
+ * @return Verdict of unambiguity.
+ */
+static bool checkReference(void *state, Map *map, path_t *path, City *city1,
+                           City *city2, list_t **exclude, bool direct) {
+    (void) state;
+    return checkIfPathDefinedUnambiguously(map, path, city1, city2, exclude,
+                                           direct);
+}
+
+/** @brief Creates search workspace.
+ * @return Pointer to workspace.
+ */
+static void *createWorkspace() {
+    return createSearchWorkspace();
+}
+
+/** @brief Deletes search workspace.
+ * @param state [in]       - pointer to workspace.
+ */
+static void destroyWorkspace(void *state) {
+    deleteSearchWorkspace((search_workspace_t *) state);
+}
+
+/** @brief Finds path using @ref searchBestPath.
+ * @param state [in,out]   - pointer to workspace,
+ * @param map [in,out]     - pointer to map,
+ * @param city1 [in,out]   - pointer to first city,
+ * @param city2 [in,out]   - pointer to last city,
+ * @param exclude [in]     - list of excluded roads,
+ * @param direct [in]      - flag indicating if direct road can be used.
+ * @return Pointer to path or NULL.
+ */
+static path_t *findWorkspace(void *state, Map *map, City *city1, City *city2,
+                             list_t **exclude, bool direct) {
+    path_status_t status;
+
+    return searchBestPath((search_workspace_t *) state, map, city1, city2,
+                          exclude, direct, INT_MIN, &status);
+}
+
+/** @brief Checks path using @ref searchIfPathDefinedUnambiguously.
+ * @param state [in,out]   - pointer to workspace,
+ * @param map [in,out]     - pointer to map,
+ * @param path [in]        - pointer to path,
+ * @param city1 [in,out]   - pointer to first city,
+ * @param city2 [in,out]   - pointer to last city,
+ * @param exclude [in]     - list of excluded roads,
+ * @param direct [in]      - flag indicating if direct road can be used.
+ * @return Verdict of unambiguity.
+ */
+static bool checkWorkspace(void *state, Map *map, path_t *path, City *city1,
+                           City *city2, list_t **exclude, bool direct) {
+    return searchIfPathDefinedUnambiguously((search_workspace_t *) state, map,
+                                            path, city1, city2, exclude,
+                                            direct, INT_MIN);
+}
+
+/**
+ * Compared engines, the first one is reference.
+ */
+static const path_engine_t engines[] = {
+        {"reference", createReference, destroyReference, findReference,
+                checkReference},
+        {"workspace", createWorkspace, destroyWorkspace, findWorkspace,
+                checkWorkspace}
+};
+
+/**
+ * Macro defining number of engines.
+ */
+#define ENGINES_NUM ARRAY_SIZE(engines)
+
+/** @brief Prints error and exits program.
+ * @param message [in]     - error message.
+ */
+static void fail(const char *message) {
+    fprintf(stderr, "path_oracle: %s\n", message);
+    exit(1);
+}
+
+/** @brief Builds random map.
+ * @param rng [in,out]     - pointer to generator,
+ * @param config [in]      - configuration of map,
+ * @param cities [out]     - array of cities indexed by city number.
+ * @return Pointer to map.
+ */
+static Map *buildMap(rng_t *rng, const map_config_t *config, City **cities) {
+    Map *map = newMap();
+    char name1[NAME_LENGTH], name2[NAME_LENGTH];
+    list_t *list, *tmp_node;
+
+    if (map == NULL)
+        fail("out of memory");
+    for (unsigned i = 0; i < config->roads_num; i++) {
+        // First roads make spanning tree, so most cities are connected.
+        unsigned city1 = i + 1 < config->cities_num
+                         ? i + 1 : (unsigned) rangeRng(rng, 0,
+                                                       config->cities_num - 1);
+        unsigned city2 = (unsigned) rangeRng(rng, 0, config->cities_num - 1);
+
+        if (i + 1 < config->cities_num && rangeRng(rng, 0, 9) > 0)
+            city2 = (unsigned) rangeRng(rng, 0, i);
+        snprintf(name1, sizeof(name1), "c%u", city1);
+        snprintf(name2, sizeof(name2), "c%u", city2);
+        addRoad(map, name1, name2,
+                (unsigned) rangeRng(rng, 1, config->max_length),
+                2000 + (int) rangeRng(rng, 0, config->years_num - 1));
+    }
+
+    list = mapGetValuesList(map->cities);
+    if (list == NULL)
+        fail("out of memory");
+    for (tmp_node = list; tmp_node->value != NULL; tmp_node = tmp_node->next)
+        cities[((City *) tmp_node->value)->id] = (City *) tmp_node->value;
+    deleteList(&list);
+    return map;
+}
+
+/** @brief Runs query in engine.
+ * @param engine [in]      - pointer to engine,
+ * @param state [in,out]   - state of engine,
+ * @param map [in,out]     - pointer to map,
+ * @param city1 [in,out]   - pointer to first city,
+ * @param city2 [in,out]   - pointer to last city,
+ * @param exclude [in]     - list of excluded roads or NULL,
+ * @param direct [in]      - flag indicating if direct road can be used,
+ * @param totals [in,out]  - totals of engine.
+ * @return Result of query.
+ */
+static query_result_t runQuery(const path_engine_t *engine, void *state,
+                               Map *map, City *city1, City *city2,
+                               list_t **exclude, bool direct,
+                               engine_totals_t *totals) {
+    query_result_t result = {NULL, false};
+    uint64_t start = getTimeNs();
+
+    result.path = engine->find(state, map, city1, city2, exclude, direct);
+    if (result.path != NULL)
+        result.unambiguous = engine->check(state, map, result.path, city1,
+                                           city2, exclude, direct);
+    totals->time += getTimeNs() - start;
+    totals->queries++;
+    totals->found += result.path != NULL;
+    totals->unambiguous += result.unambiguous;
+    return result;
+}
+
+/** @brief Checks if results of queries are the same.
+ * @param reference [in]   - result of reference engine,
+ * @param result [in]      - result of compared engine.
+ * @return Value @p true if results are the same. Otherwise value @p false.
+ */
+static bool compareResults(const query_result_t *reference,
+                           const query_result_t *result) {
+    list_t *node1, *node2;
+
+    if ((reference->path == NULL) != (result->path == NULL))
+        return false;
+    if (reference->path == NULL)
+        return true;
+    if (reference->path->total_len != result->path->total_len ||
+        reference->path->year != result->path->year ||
+        reference->unambiguous != result->unambiguous)
+        return false;
+    if (!reference->unambiguous)
+        return true;
+
+    node1 = reference->path->roads;
+    node2 = result->path->roads;
+    while (node1->value != NULL && node2->value != NULL) {
+        if (node1->value != node2->value)
+            return false;
+        node1 = node1->next;
+        node2 = node2->next;
+    }
+    return node1->value == node2->value;
+}
+
+/** @brief Prints mismatch of results.
+ * @param engine [in]      - name of engine,
+ * @param kind [in]        - kind of query,
+ * @param city1 [in]       - pointer to first city,
+ * @param city2 [in]       - pointer to last city,
+ * @param reference [in]   - result of reference engine,
+ * @param result [in]      - result of compared engine.
+ */
+static void printMismatch(const char *engine, query_kind_t kind, City *city1,
+                          City *city2, const query_result_t *reference,
+                          const query_result_t *result) {
+    fprintf(stderr, "mismatch engine=%s query=%s from=%s to=%s "
+                    "reference=%u/%d/%d result=%u/%d/%d\n", engine,
+            query_names[kind], city1->name, city2->name,
+            reference->path == NULL ? 0 : reference->path->total_len,
+            reference->path == NULL ? 0 : reference->path->year,
+            reference->unambiguous,
+            result->path == NULL ? 0 : result->path->total_len,
+            result->path == NULL ? 0 : result->path->year,
+            result->unambiguous);
+}
+
+/** @brief Runs random queries on one map in all engines.
+ * @param rng [in,out]     - pointer to generator,
+ * @param map [in,out]     - pointer to map,
+ * @param cities [in]      - array of cities,
+ * @param cities_num [in]  - number of cities,
+ * @param queries [in]     - number of queries,
+ * @param states [in,out]  - states of engines,
+ * @param totals [in,out]  - totals of engines indexed by engine and kind.
+ */
+static void runQueries(rng_t *rng, Map *map, City **cities,
+                       unsigned cities_num, unsigned queries, void **states,
+                       engine_totals_t totals[][QUERY_KINDS_NUM]) {
+    static unsigned long printed = 0;
+
+    for (unsigned q = 0; q < queries; q++) {
+        query_kind_t kind = (query_kind_t) (q % QUERY_KINDS_NUM);
+        City *city1 = cities[rangeRng(rng, 0, cities_num - 1)];
+        City *city2 = cities[rangeRng(rng, 0, cities_num - 1)];
+        path_t *route = NULL;
+        list_t **exclude = NULL;
+        bool direct = true;
+        query_result_t results[ENGINES_NUM];
+
+        if (city1 == city2)
+            continue;
+
+        if (kind != QUERY_NEW_ROUTE) {
+            // Route is best path between two random cities.
+            route = findBestPath(map, city1, city2, NULL, true);
+            if (route == NULL)
+                continue;
+            exclude = &route->roads;
+            if (kind == QUERY_EXTEND_ROUTE) {
+                city2 = cities[rangeRng(rng, 0, cities_num - 1)];
+            } else {
+                // Random road of route.
+                list_t *tmp_node = route->roads;
+                unsigned roads_num = 0;
+
+                while (tmp_node->value != NULL) {
+                    roads_num++;
+                    tmp_node = tmp_node->next;
+                }
+                tmp_node = route->roads;
+                for (unsigned i = (unsigned) rangeRng(rng, 0, roads_num - 1);
+                     i > 0; i--)
+                    tmp_node = tmp_node->next;
+                city1 = ((Road *) tmp_node->value)->city1;
+                city2 = ((Road *) tmp_node->value)->city2;
+                if (rangeRng(rng, 0, 1) == 1) {
+                    City *tmp_city = city1;
+                    city1 = city2;
+                    city2 = tmp_city;
+                }
+                direct = false;
+            }
+        }
+        if (city1 == city2) {
+            deletePath(route);
+            continue;
+        }
+
+        for (size_t e = 0; e < ENGINES_NUM; e++)
+            results[e] = runQuery(&engines[e], states[e], map, city1, city2,
+                                  exclude, direct, &totals[e][kind]);
+        for (size_t e = 1; e < ENGINES_NUM; e++) {
+            if (!compareResults(&results[0], &results[e])) {
+                totals[e][kind].mismatches++;
+                if (printed++ < MAX_PRINTED_MISMATCHES)
+                    printMismatch(engines[e].name, kind, city1, city2,
+                                  &results[0], &results[e]);
+            }
+        }
+
+        for (size_t e = 0; e < ENGINES_NUM; e++)
+            deletePath(results[e].path);
+        deletePath(route);
+    }
+}
+
+/** @brief Prints usage of program.
+ * @param program [in]     - name of program.
+ */
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--seed N] [--scale N] [--queries N]\n",
+            program);
+}
+
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+            {"seed",    required_argument, NULL, 's'},
+            {"scale",   required_argument, NULL, 'm'},
+            {"queries", required_argument, NULL, 'q'},
+            {NULL, 0,                      NULL, 0}
+    };
+    uint64_t seed = 1;
+    unsigned scale = 1, queries = 100;
+    unsigned long mismatches = 0;
+    rng_t rng;
+    int option;
+
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'm':
+                scale = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+            case 'q':
+                queries = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+            default:
+                printUsage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc || scale == 0 || queries == 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    initRng(&rng, seed);
+    printf("%-8s %-6s %-11s %-9s %8s %8s %11s %10s %10s %8s\n", "cities",
+           "roads", "query", "engine", "queries", "found", "unambiguous",
+           "mismatches", "time_us", "speedup");
+
+    for (size_t c = 0; c < ARRAY_SIZE(configs); c++) {
+        engine_totals_t totals[ENGINES_NUM][QUERY_KINDS_NUM] = {{{0}}};
+        City **cities = (City **) calloc(configs[c].cities_num,
+                                         sizeof(City *));
+        void *states[ENGINES_NUM];
+
+        if (cities == NULL)
+            fail("out of memory");
+        for (unsigned m = 0; m < configs[c].maps * scale; m++) {
+            Map *map = buildMap(&rng, &configs[c], cities);
+
+            for (size_t e = 0; e < ENGINES_NUM; e++)
+                states[e] = engines[e].create();
+            runQueries(&rng, map, cities, map->cities_num, queries, states,
+                       totals);
+            for (size_t e = 0; e < ENGINES_NUM; e++)
+                engines[e].destroy(states[e]);
+            deleteMap(map);
+        }
+
+        for (int k = 0; k < QUERY_KINDS_NUM; k++) {
+            for (size_t e = 0; e < ENGINES_NUM; e++) {
+                engine_totals_t *curr = &totals[e][k];
+
+                printf("%-8u %-6u %-11s %-9s %8lu %8lu %11lu %10lu %10llu "
+                       "%8.2f\n", configs[c].cities_num, configs[c].roads_num,
+                       query_names[k], engines[e].name, curr->queries,
+                       curr->found, curr->unambiguous, curr->mismatches,
+                       (unsigned long long) (curr->time / 1000),
+                       curr->time == 0 ? 0.0 : (double) totals[0][k].time /
+                                               (double) curr->time);
+                mismatches += curr->mismatches;
+            }
+        }
+        fflush(stdout);
+        free(cities);
+    }
+
+    printf("mismatches=%lu\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
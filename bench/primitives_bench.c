@@ -0,0 +1,485 @@
+/** @file
+ * Microbenchmark of data structures used by map module.
+ * Measures operations of AVL map with string keys, heap used by Dijkstra
+ * algorithm and linked list. Every measurement is repeated and results are
+ * printed as CSV: structure, operation, number of elements, key length,
+ * number of operations in one repetition and minimal and median time of
+ * one operation in nanoseconds.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <getopt.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avl_map.h"
+#include "bench_utils.h"
+#include "command_stats.h"
+#include "heap.h"
+#include "list.h"
+#include "roads_types.h"
+#include "utils.h"
+
+/**
+ * Macro defining maximal number of repetitions.
+ */
+#define MAX_REPEAT 101
+
+/**
+ * Numbers of elements of AVL map.
+ */
+static const size_t map_sizes[] = {1000, 10000, 100000};
+
+/**
+ * Lengths of keys of AVL map.
+ */
+static const size_t key_lengths[] = {8, 32, 128};
+
+/**
+ * Numbers of cities in heap.
+ */
+static const size_t heap_sizes[] = {1024, 16384, 262144};
+
+/**
+ * Numbers of elements of list.
+ */
+static const size_t list_sizes[] = {100, 1000, 10000};
+
+/**
+ * Macro counting elements of array.
+ */
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+/**
+ * Structure representing measured operation.
+ */
+typedef struct measure {
+    const char *structure;      /**< Name of structure. */
+    const char *operation;      /**< Name of operation. */
+    size_t size;                /**< Number of elements. */
+    size_t key_length;          /**< Key length or 0. */
+    size_t ops;                 /**< Number of operations in repetition. */
+    unsigned repeat;            /**< Number of repetitions. */
+    uint64_t times[MAX_REPEAT]; /**< Times of repetitions in nanoseconds. */
+} measure_t;
+
+/** @brief Prints error and exits program.
+ * @param message [in]     - error message.
+ */
+static void fail(const char *message) {
+    fprintf(stderr, "primitives_bench: %s\n", message);
+    exit(1);
+}
+
+/** @brief Compares times.
+ * @param a [in]           - pointer to first time,
+ * @param b [in]           - pointer to second time.
+ * @return Negative, zero or positive number like strcmp.
+ */
+static int compareTimes(const void *a, const void *b) {
+    uint64_t time1 = *(const uint64_t *) a, time2 = *(const uint64_t *) b;
+
+    return (time1 > time2) - (time1 < time2);
+}
+
+/** @brief Prints CSV line with result of measurement.
+ * Median of even number of repetitions is average of two middle ones.
+ * @param measure [in,out] - pointer to measurement.
+ */
+static void printMeasure(measure_t *measure) {
+    double median;
+
+    qsort(measure->times, measure->repeat, sizeof(uint64_t), compareTimes);
+    median = ((double) measure->times[(measure->repeat - 1) / 2] +
+              (double) measure->times[measure->repeat / 2]) / 2;
+    printf("%s,%s,%zu,%zu,%zu,%.2f,%.2f\n", measure->structure,
+           measure->operation, measure->size, measure->key_length,
+           measure->ops, (double) measure->times[0] / (double) measure->ops,
+           median / (double) measure->ops);
+    fflush(stdout);
+}
+
+/** @brief Initiates measurement.
+ * @param measure [out]    - pointer to measurement,
+ * @param structure [in]   - name of structure,
+ * @param operation [in]   - name of operation,
+ * @param size [in]        - number of elements,
+ * @param key_length [in]  - key length,
+ * @param ops [in]         - number of operations in repetition.
+ */
+static void initMeasure(measure_t *measure, const char *structure,
+                        const char *operation, size_t size, size_t key_length,
+                        size_t ops) {
+    measure->structure = structure;
+    measure->operation = operation;
+    measure->size = size;
+    measure->key_length = key_length;
+    measure->ops = ops;
+    measure->repeat = 0;
+}
+
+/** @brief Generates random keys.
+ * Keys have common prefix, so comparisons have to read more characters.
+ * Key length has to allow distinct keys.
+ * @param rng [in,out]     - pointer to generator,
+ * @param keys_num [in]    - number of keys,
+ * @param key_length [in]  - length of key.
+ * @return Array of keys.
+ */
+static char **generateKeys(rng_t *rng, size_t keys_num, size_t key_length) {
+    char **keys = (char **) malloc(sizeof(char *) * keys_num);
+    size_t digits = 0;
+
+    if (keys == NULL)
+        fail("out of memory");
+    for (size_t range = 1; range < keys_num; range *= 26)
+        digits++;
+    for (size_t i = 0; i < keys_num; i++) {
+        keys[i] = (char *) malloc(key_length + 1);
+        if (keys[i] == NULL)
+            fail("out of memory");
+        size_t number = i;
+
+        for (size_t j = 0; j < key_length; j++)
+            keys[i][j] = j < key_length / 2
+                         ? 'a' : (char) ('a' + rangeRng(rng, 0, 25));
+        // Last characters encode number of key, so keys are unique.
+        for (size_t j = key_length; j > key_length - digits; j--) {
+            keys[i][j - 1] = (char) ('a' + number % 26);
+            number /= 26;
+        }
+        keys[i][key_length] = '\0';
+    }
+    return keys;
+}
+
+/** @brief Shuffles array of pointers.
+ * @param rng [in,out]     - pointer to generator,
+ * @param array [in,out]   - array,
+ * @param n [in]           - size of array.
+ */
+static void shuffle(rng_t *rng, void **array, size_t n) {
+    for (size_t i = n; i > 1; i--) {
+        size_t j = rangeRng(rng, 0, i - 1);
+        void *tmp = array[i - 1];
+
+        array[i - 1] = array[j];
+        array[j] = tmp;
+    }
+}
+
+/** @brief Measures operations of AVL map.
+ * @param rng [in,out]     - pointer to generator,
+ * @param size [in]        - number of keys,
+ * @param key_length [in]  - length of key,
+ * @param repeat [in]      - number of repetitions.
+ */
+static void benchAvlMap(rng_t *rng, size_t size, size_t key_length,
+                        unsigned repeat) {
+    char **keys = generateKeys(rng, size, key_length);
+    measure_t insert, get, values, remove;
+    size_t values_calls = size >= 100000 ? 10 : 100;
+
+    initMeasure(&insert, "avl_map", "mapInsert", size, key_length, size);
+    initMeasure(&get, "avl_map", "mapGet", size, key_length, size);
+    initMeasure(&values, "avl_map", "mapGetValuesList", size, key_length,
+                values_calls);
+    initMeasure(&remove, "avl_map", "mapRemove", size, key_length, size);
+
+    for (unsigned r = 0; r < repeat; r++) {
+        map_t *map = mapInit(cityNameCmp, cityNameEq, printCityName, NULL,
+                             NULL);
+        uint64_t start;
+
+        if (map == NULL)
+            fail("out of memory");
+
+        shuffle(rng, (void **) keys, size);
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++) {
+            if (!mapInsert(map, keys[i], keys[i]))
+                fail("out of memory");
+        }
+        insert.times[insert.repeat++] = getTimeNs() - start;
+
+        shuffle(rng, (void **) keys, size);
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++) {
+            if (mapGet(map, keys[i]) != keys[i])
+                fail("mapGet returned wrong value");
+        }
+        get.times[get.repeat++] = getTimeNs() - start;
+
+        start = getTimeNs();
+        for (size_t i = 0; i < values_calls; i++) {
+            list_t *list = mapGetValuesList(map);
+
+            if (list == NULL)
+                fail("out of memory");
+            deleteList(&list);
+        }
+        values.times[values.repeat++] = getTimeNs() - start;
+
+        shuffle(rng, (void **) keys, size);
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++)
+            mapRemove(map, keys[i], 0);
+        remove.times[remove.repeat++] = getTimeNs() - start;
+
+        mapDelete(map, 0);
+    }
+
+    printMeasure(&insert);
+    printMeasure(&get);
+    printMeasure(&values);
+    printMeasure(&remove);
+
+    for (size_t i = 0; i < size; i++)
+        free(keys[i]);
+    free(keys);
+}
+
+/** @brief Fills heap with all cities.
+ * @param heap [in,out]    - pointer to heap,
+ * @param cities [in,out]  - array of cities,
+ * @param size [in]        - number of cities.
+ */
+static void fillHeap(heap_t *heap, City *cities, size_t size) {
+    list_t *list = newList();
+
+    if (list == NULL)
+        fail("out of memory");
+    for (size_t i = size; i > 0; i--) {
+        if (!addList(&list, &cities[i - 1]))
+            fail("out of memory");
+    }
+    heap->size = size;
+    fillHeapWithCitiesFromList(heap, &list);
+    deleteList(&list);
+}
+
+/** @brief Computes length of road of grid used by heap benchmark.
+ * @param city1 [in]       - number of first city,
+ * @param city2 [in]       - number of second city.
+ * @return Length from 1 to 100.
+ */
+static unsigned gridLength(size_t city1, size_t city2) {
+    uint64_t hash = (city1 < city2 ? city1 * 2654435761u + city2
+                                   : city2 * 2654435761u + city1);
+
+    hash ^= hash >> 17;
+    hash *= 0xED5AD4BBu;
+    return (unsigned) (hash >> 11) % 100 + 1;
+}
+
+/** @brief Measures operations of heap.
+ * Dijkstra access pattern is Dijkstra algorithm on square grid, its time
+ * is divided by number of pops and decrease-key operations.
+ * @param rng [in,out]     - pointer to generator,
+ * @param size [in]        - number of cities,
+ * @param repeat [in]      - number of repetitions.
+ */
+static void benchHeap(rng_t *rng, size_t size, unsigned repeat) {
+    City *cities = (City *) calloc(size, sizeof(City));
+    heap_t *heap = createHeap(size);
+    size_t side = 1;
+    measure_t pop, decrease, dijkstra;
+
+    if (cities == NULL || heap == NULL)
+        fail("out of memory");
+    while (side * side < size)
+        side++;
+
+    initMeasure(&pop, "heap", "popHeap", size, 0, size);
+    initMeasure(&decrease, "heap", "decreaseHeapKey", size, 0, size);
+    initMeasure(&dijkstra, "heap", "dijkstra", size, 0, 0);
+
+    for (unsigned r = 0; r < repeat; r++) {
+        uint64_t start;
+        size_t ops = 0;
+
+        // Random decreases of full heap.
+        fillHeap(heap, cities, size);
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++) {
+            City *city = &cities[rangeRng(rng, 0, size - 1)];
+            decreaseHeapKey(heap, city->num_in_heap,
+                            (unsigned) rangeRng(rng, 0, 1u << 30),
+                            (int) rangeRng(rng, 1950, 2020));
+        }
+        decrease.times[decrease.repeat++] = getTimeNs() - start;
+
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++)
+            popHeap(heap);
+        pop.times[pop.repeat++] = getTimeNs() - start;
+
+        // Dijkstra algorithm on grid.
+        fillHeap(heap, cities, size);
+        start = getTimeNs();
+        decreaseHeapKey(heap, cities[0].num_in_heap, 0, INT_MAX);
+        for (size_t i = 0; i < size; i++) {
+            heap_node_t *node = popHeap(heap);
+            size_t city = (size_t) (node->city - cities);
+            size_t neighbours[4];
+            int neighbours_num = 0;
+
+            ops++;
+            if (node->total_len == UINT_MAX)
+                continue;
+            if (city % side > 0)
+                neighbours[neighbours_num++] = city - 1;
+            if (city % side + 1 < side && city + 1 < size)
+                neighbours[neighbours_num++] = city + 1;
+            if (city >= side)
+                neighbours[neighbours_num++] = city - side;
+            if (city + side < size)
+                neighbours[neighbours_num++] = city + side;
+
+            for (int k = 0; k < neighbours_num; k++) {
+                size_t next = neighbours[k];
+                decreaseHeapKey(heap, cities[next].num_in_heap,
+                                node->total_len + gridLength(city, next),
+                                node->year);
+                ops++;
+            }
+        }
+        dijkstra.times[dijkstra.repeat++] = getTimeNs() - start;
+        dijkstra.ops = ops;
+    }
+
+    printMeasure(&decrease);
+    printMeasure(&pop);
+    printMeasure(&dijkstra);
+
+    deleteHeap(heap);
+    free(cities);
+}
+
+/** @brief Measures operations of list.
+ * @param rng [in,out]     - pointer to generator,
+ * @param size [in]        - number of elements,
+ * @param repeat [in]      - number of repetitions.
+ */
+static void benchList(rng_t *rng, size_t size, unsigned repeat) {
+    void **values = (void **) malloc(sizeof(void *) * size);
+    measure_t add, contains, remove;
+    size_t searches = size < 1000 ? 1000 : size;
+
+    if (values == NULL)
+        fail("out of memory");
+    for (size_t i = 0; i < size; i++)
+        values[i] = (void *) (i + 1);
+
+    initMeasure(&add, "list", "addList", size, 0, size);
+    initMeasure(&contains, "list", "containsList", size, 0, searches);
+    initMeasure(&remove, "list", "removeList", size, 0, size);
+
+    for (unsigned r = 0; r < repeat; r++) {
+        list_t *list = newList();
+        uint64_t start;
+        size_t found = 0;
+
+        if (list == NULL)
+            fail("out of memory");
+
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++) {
+            if (!addList(&list, values[i]))
+                fail("out of memory");
+        }
+        add.times[add.repeat++] = getTimeNs() - start;
+
+        start = getTimeNs();
+        for (size_t i = 0; i < searches; i++)
+            found += containsList(&list, values[rangeRng(rng, 0, size - 1)]);
+        contains.times[contains.repeat++] = getTimeNs() - start;
+        if (found != searches)
+            fail("containsList didn't find value");
+
+        shuffle(rng, values, size);
+        start = getTimeNs();
+        for (size_t i = 0; i < size; i++)
+            removeList(&list, values[i]);
+        remove.times[remove.repeat++] = getTimeNs() - start;
+
+        deleteList(&list);
+    }
+
+    printMeasure(&add);
+    printMeasure(&contains);
+    printMeasure(&remove);
+    free(values);
+}
+
+/** @brief Prints usage of program.
+ * @param program [in]     - name of program.
+ */
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--seed N] [--repeat N]"
+                    " [--only avl_map|heap|list]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+            {"seed",   required_argument, NULL, 's'},
+            {"repeat", required_argument, NULL, 'r'},
+            {"only",   required_argument, NULL, 'o'},
+            {NULL, 0,                     NULL, 0}
+    };
+    uint64_t seed = 1;
+    unsigned repeat = 5;
+    const char *only = NULL;
+    rng_t rng;
+    int option;
+
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'r':
+                repeat = (unsigned) strtoul(optarg, NULL, 10);
+                if (repeat == 0 || repeat > MAX_REPEAT) {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'o':
+                only = optarg;
+                break;
+            default:
+                printUsage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    initRng(&rng, seed);
+    printf("structure,operation,size,key_length,ops,ns_per_op_min,"
+           "ns_per_op_median\n");
+
+    if (only == NULL || strcmp(only, "avl_map") == 0) {
+        for (size_t i = 0; i < ARRAY_SIZE(map_sizes); i++) {
+            for (size_t j = 0; j < ARRAY_SIZE(key_lengths); j++)
+                benchAvlMap(&rng, map_sizes[i], key_lengths[j], repeat);
+        }
+    }
+    if (only == NULL || strcmp(only, "heap") == 0) {
+        for (size_t i = 0; i < ARRAY_SIZE(heap_sizes); i++)
+            benchHeap(&rng, heap_sizes[i], repeat);
+    }
+    if (only == NULL || strcmp(only, "list") == 0) {
+        for (size_t i = 0; i < ARRAY_SIZE(list_sizes); i++)
+            benchList(&rng, list_sizes[i], repeat);
+    }
+    return 0;
+}
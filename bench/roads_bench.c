@@ -0,0 +1,723 @@
+/** @file
+ * End-to-end benchmark of map module.
+ * Generates synthetic road networks, adds them to map and runs mixes of
+ * commands through interface of map module. Reports throughput and latency
+ * percentiles of every command. All data is generated from seed, so runs
+ * with the same seed are comparable.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_utils.h"
+#include "command_stats.h"
+#include "histogram.h"
+#include "map.h"
+
+/**
+ * Macro defining size of buffer for city name.
+ */
+#define CITY_NAME_LENGTH 16
+/**
+ * Macro defining number of routes created before removal-heavy mix.
+ */
+#define REMOVAL_ROUTES 200
+
+/**
+ * Type of synthetic network.
+ */
+typedef enum network_type {
+    NETWORK_GRID,               /**< Square grid. */
+    NETWORK_GEOMETRIC,          /**< Random geometric graph. */
+    NETWORK_SCALE_FREE,         /**< Scale-free network of trunk and
+                                     branches. */
+    NETWORKS_NUM                /**< Number of types of network. */
+} network_type_t;
+
+/**
+ * Mix of commands.
+ */
+typedef enum command_mix {
+    MIX_INGEST,                 /**< Mostly adding and repairing roads. */
+    MIX_ROUTE,                  /**< Mostly creating and reading routes. */
+    MIX_REMOVAL,                /**< Mostly removing roads used by routes. */
+    MIXES_NUM                   /**< Number of mixes. */
+} command_mix_t;
+
+/**
+ * Benchmarked command.
+ */
+typedef enum bench_command {
+    BENCH_ADD_ROAD,             /**< Function addRoad. */
+    BENCH_REPAIR_ROAD,          /**< Function repairRoad. */
+    BENCH_NEW_ROUTE,            /**< Function newRoute. */
+    BENCH_EXTEND_ROUTE,         /**< Function extendRoute. */
+    BENCH_GET_ROUTE_DESCRIPTION, /**< Function getRouteDescription. */
+    BENCH_REMOVE_ROAD,          /**< Function removeRoad. */
+    BENCH_REMOVE_ROUTE,         /**< Function removeRoute. */
+    BENCH_COMMANDS_NUM          /**< Number of commands. */
+} bench_command_t;
+
+/**
+ * Names of types of network.
+ */
+static const char *const network_names[NETWORKS_NUM] = {
+        "grid", "geometric", "scalefree"
+};
+
+/**
+ * Names of mixes of commands.
+ */
+static const char *const mix_names[MIXES_NUM] = {
+        "ingest", "route", "removal"
+};
+
+/**
+ * Names of benchmarked commands.
+ */
+static const char *const command_names[BENCH_COMMANDS_NUM] = {
+        "addRoad", "repairRoad", "newRoute", "extendRoute",
+        "getRouteDescription", "removeRoad", "removeRoute"
+};
+
+/**
+ * Names of sizes of network.
+ */
+static const char *const size_names[] = {"small", "medium", "large"};
+
+/**
+ * Numbers of cities of networks of every size.
+ */
+static const unsigned size_cities[] = {1000, 10000, 50000};
+
+/**
+ * Macro defining number of sizes of network.
+ */
+#define SIZES_NUM (sizeof(size_cities) / sizeof(size_cities[0]))
+
+/**
+ * Structure describing generated road.
+ */
+typedef struct bench_road {
+    unsigned city1;             /**< Number of first city. */
+    unsigned city2;             /**< Number of second city. */
+    unsigned length;            /**< Length of road. */
+    int year;                   /**< Built year. */
+    bool removed;               /**< Flag indicating if road was removed. */
+} bench_road_t;
+
+/**
+ * Structure representing generated network.
+ */
+typedef struct network {
+    unsigned cities_num;        /**< Number of cities. */
+    char (*names)[CITY_NAME_LENGTH];    /**< City names. */
+    bench_road_t *roads;        /**< Array of roads. */
+    size_t roads_num;           /**< Number of roads. */
+    size_t roads_capacity;      /**< Size of array of roads. */
+} network_t;
+
+/**
+ * Structure storing results of benchmark.
+ */
+typedef struct bench_result {
+    uint64_t ok[BENCH_COMMANDS_NUM];            /**< Numbers of successful
+                                                     calls. */
+    histogram_t latency[BENCH_COMMANDS_NUM];    /**< Latencies in
+                                                     nanoseconds. */
+} bench_result_t;
+
+/**
+ * Structure representing options of benchmark.
+ */
+typedef struct bench_options {
+    uint64_t seed;              /**< Seed of generator. */
+    unsigned ops;               /**< Number of commands of every mix. */
+    bool networks[NETWORKS_NUM];    /**< Flags of selected networks. */
+    bool sizes[SIZES_NUM];          /**< Flags of selected sizes. */
+    bool mixes[MIXES_NUM];          /**< Flags of selected mixes. */
+} bench_options_t;
+
+/** @brief Prints error and exits program.
+ * @param message [in]     - error message.
+ */
+static void fail(const char *message) {
+    fprintf(stderr, "roads_bench: %s\n", message);
+    exit(1);
+}
+
+/** @brief Adds road to network.
+ * @param network [in,out] - pointer to network,
+ * @param city1 [in]       - number of first city,
+ * @param city2 [in]       - number of second city,
+ * @param length [in]      - length of road,
+ * @param year [in]        - built year.
+ */
+static void addNetworkRoad(network_t *network, unsigned city1, unsigned city2,
+                           unsigned length, int year) {
+    if (network->roads_num == network->roads_capacity) {
+        network->roads_capacity = network->roads_capacity == 0
+                                  ? 1024 : 2 * network->roads_capacity;
+        network->roads = (bench_road_t *) realloc(
+                network->roads, sizeof(bench_road_t) *
+                                network->roads_capacity);
+        if (network->roads == NULL)
+            fail("out of memory");
+    }
+
+    network->roads[network->roads_num].city1 = city1;
+    network->roads[network->roads_num].city2 = city2;
+    network->roads[network->roads_num].length = length;
+    network->roads[network->roads_num].year = year;
+    network->roads[network->roads_num].removed = false;
+    network->roads_num++;
+}
+
+/** @brief Generates square grid.
+ * Every city is connected with right and lower neighbour.
+ * @param network [in,out] - pointer to network with set number of cities,
+ * @param rng [in,out]     - pointer to generator.
+ */
+static void generateGrid(network_t *network, rng_t *rng) {
+    unsigned side = (unsigned) ceil(sqrt((double) network->cities_num));
+
+    network->cities_num = side * side;
+    for (unsigned i = 0; i < side; i++) {
+        for (unsigned j = 0; j < side; j++) {
+            if (j + 1 < side)
+                addNetworkRoad(network, i * side + j, i * side + j + 1,
+                               (unsigned) rangeRng(rng, 1, 100),
+                               (int) rangeRng(rng, 1950, 2020));
+            if (i + 1 < side)
+                addNetworkRoad(network, i * side + j, (i + 1) * side + j,
+                               (unsigned) rangeRng(rng, 1, 100),
+                               (int) rangeRng(rng, 1950, 2020));
+        }
+    }
+}
+
+/** @brief Generates random geometric graph.
+ * Cities are random points in unit square. Cities closer than radius giving
+ * average degree about 6 are connected with road of length proportional to
+ * distance. Close cities are found using grid of cells of radius size.
+ * @param network [in,out] - pointer to network with set number of cities,
+ * @param rng [in,out]     - pointer to generator.
+ */
+static void generateGeometric(network_t *network, rng_t *rng) {
+    unsigned n = network->cities_num;
+    double radius = sqrt(6.0 / (M_PI * n));
+    unsigned cells_side = (unsigned) (1.0 / radius) + 1;
+    double *x = (double *) malloc(sizeof(double) * n);
+    double *y = (double *) malloc(sizeof(double) * n);
+    unsigned *cell_first = (unsigned *) malloc(sizeof(unsigned) *
+                                               (cells_side * cells_side + 1));
+    unsigned *cell_cities = (unsigned *) malloc(sizeof(unsigned) * n);
+
+    if (x == NULL || y == NULL || cell_first == NULL || cell_cities == NULL)
+        fail("out of memory");
+
+    // Counting sort of cities by cell.
+    memset(cell_first, 0, sizeof(unsigned) * (cells_side * cells_side + 1));
+    for (unsigned i = 0; i < n; i++) {
+        x[i] = unitRng(rng);
+        y[i] = unitRng(rng);
+        cell_first[(unsigned) (y[i] / radius) * cells_side +
+                   (unsigned) (x[i] / radius) + 1]++;
+    }
+    for (unsigned i = 0; i < cells_side * cells_side; i++)
+        cell_first[i + 1] += cell_first[i];
+    for (unsigned i = 0; i < n; i++) {
+        unsigned cell = (unsigned) (y[i] / radius) * cells_side +
+                        (unsigned) (x[i] / radius);
+        cell_cities[--cell_first[cell + 1]] = i;
+    }
+
+    for (unsigned i = 0; i < n; i++) {
+        int cell_x = (int) (x[i] / radius), cell_y = (int) (y[i] / radius);
+
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int cx = cell_x + dx, cy = cell_y + dy;
+                unsigned cell;
+
+                if (cx < 0 || cy < 0 || cx >= (int) cells_side ||
+                    cy >= (int) cells_side)
+                    continue;
+                cell = (unsigned) cy * cells_side + (unsigned) cx;
+                for (unsigned k = cell_first[cell]; k < cell_first[cell + 1];
+                     k++) {
+                    unsigned j = cell_cities[k];
+                    double distance = hypot(x[i] - x[j], y[i] - y[j]);
+
+                    if (j > i && distance < radius)
+                        addNetworkRoad(network, i, j,
+                                       (unsigned) (distance * 10000) + 1,
+                                       (int) rangeRng(rng, 1950, 2020));
+                }
+            }
+        }
+    }
+
+    free(x);
+    free(y);
+    free(cell_first);
+    free(cell_cities);
+}
+
+/** @brief Generates scale-free network of trunk and branches.
+ * Uses preferential attachment: every new city is connected with two
+ * different cities chosen with probability proportional to their degree.
+ * Roads between hubs (first 2% of cities) form long trunk roads, other roads
+ * are short branches.
+ * @param network [in,out] - pointer to network with set number of cities,
+ * @param rng [in,out]     - pointer to generator.
+ */
+static void generateScaleFree(network_t *network, rng_t *rng) {
+    unsigned n = network->cities_num;
+    unsigned hubs = n / 50 > 3 ? n / 50 : 3;
+    unsigned *ends = (unsigned *) malloc(sizeof(unsigned) * 4 * n);
+    size_t ends_num = 0;
+
+    if (ends == NULL)
+        fail("out of memory");
+
+    for (unsigned i = 0; i < 3; i++) {
+        for (unsigned j = i + 1; j < 3; j++) {
+            addNetworkRoad(network, i, j, (unsigned) rangeRng(rng, 100, 300),
+                           (int) rangeRng(rng, 1950, 2020));
+            ends[ends_num++] = i;
+            ends[ends_num++] = j;
+        }
+    }
+
+    for (unsigned i = 3; i < n; i++) {
+        unsigned first = ends[rangeRng(rng, 0, ends_num - 1)];
+        unsigned second;
+
+        do {
+            second = ends[rangeRng(rng, 0, ends_num - 1)];
+        } while (second == first);
+
+        for (int k = 0; k < 2; k++) {
+            unsigned other = k == 0 ? first : second;
+            bool trunk = i < hubs && other < hubs;
+
+            addNetworkRoad(network, other, i,
+                           (unsigned) (trunk ? rangeRng(rng, 100, 300)
+                                             : rangeRng(rng, 1, 30)),
+                           (int) rangeRng(rng, 1950, 2020));
+            ends[ends_num++] = other;
+            ends[ends_num++] = i;
+        }
+    }
+    free(ends);
+}
+
+/** @brief Generates network.
+ * @param network [out]    - pointer to network,
+ * @param type [in]        - type of network,
+ * @param cities_num [in]  - number of cities,
+ * @param seed [in]        - seed of generator.
+ */
+static void generateNetwork(network_t *network, network_type_t type,
+                            unsigned cities_num, uint64_t seed) {
+    rng_t rng;
+
+    initRng(&rng, seed);
+    network->cities_num = cities_num;
+    network->roads = NULL;
+    network->roads_num = 0;
+    network->roads_capacity = 0;
+
+    switch (type) {
+        case NETWORK_GRID:
+            generateGrid(network, &rng);
+            break;
+        case NETWORK_GEOMETRIC:
+            generateGeometric(network, &rng);
+            break;
+        default:
+            generateScaleFree(network, &rng);
+            break;
+    }
+
+    network->names = malloc(sizeof(*network->names) * network->cities_num);
+    if (network->names == NULL)
+        fail("out of memory");
+    for (unsigned i = 0; i < network->cities_num; i++)
+        snprintf(network->names[i], CITY_NAME_LENGTH, "c%u", i);
+}
+
+/** @brief Deletes network.
+ * @param network [in,out] - pointer to network.
+ */
+static void deleteNetwork(network_t *network) {
+    free(network->names);
+    free(network->roads);
+}
+
+/** @brief Records call of command.
+ * @param result [in,out]  - pointer to results,
+ * @param command [in]     - benchmarked command,
+ * @param ok [in]          - result of command,
+ * @param start [in]       - start time of call.
+ */
+static void recordCall(bench_result_t *result, bench_command_t command,
+                       bool ok, uint64_t start) {
+    recordHistogram(&result->latency[command], getTimeNs() - start);
+    if (ok)
+        result->ok[command]++;
+}
+
+/** @brief Adds road of network to map.
+ * @param map [in,out]     - pointer to map,
+ * @param network [in]     - pointer to network,
+ * @param road [in]        - pointer to road,
+ * @param result [in,out]  - pointer to results.
+ * @return Value @p true if road was added. Otherwise value @p false.
+ */
+static bool benchAddRoad(Map *map, const network_t *network,
+                         const bench_road_t *road, bench_result_t *result) {
+    uint64_t start = getTimeNs();
+    bool ok = addRoad(map, network->names[road->city1],
+                      network->names[road->city2], road->length, road->year);
+
+    recordCall(result, BENCH_ADD_ROAD, ok, start);
+    return ok;
+}
+
+/** @brief Creates route between random cities.
+ * @param map [in,out]     - pointer to map,
+ * @param network [in]     - pointer to network,
+ * @param rng [in,out]     - pointer to generator,
+ * @param result [in,out]  - pointer to results.
+ */
+static void benchNewRoute(Map *map, const network_t *network, rng_t *rng,
+                          bench_result_t *result) {
+    unsigned route = (unsigned) rangeRng(rng, 1, 999);
+    unsigned city1 = (unsigned) rangeRng(rng, 0, network->cities_num - 1);
+    unsigned city2 = (unsigned) rangeRng(rng, 0, network->cities_num - 1);
+    uint64_t start = getTimeNs();
+    bool ok = newRoute(map, route, network->names[city1],
+                       network->names[city2]);
+
+    recordCall(result, BENCH_NEW_ROUTE, ok, start);
+}
+
+/** @brief Reads description of random route.
+ * @param map [in,out]     - pointer to map,
+ * @param rng [in,out]     - pointer to generator,
+ * @param result [in,out]  - pointer to results.
+ */
+static void benchGetRouteDescription(Map *map, rng_t *rng,
+                                     bench_result_t *result) {
+    unsigned route = (unsigned) rangeRng(rng, 1, 999);
+    uint64_t start = getTimeNs();
+    const char *description = getRouteDescription(map, route);
+
+    recordCall(result, BENCH_GET_ROUTE_DESCRIPTION, description != NULL,
+               start);
+    free((void *) description);
+}
+
+/** @brief Runs ingest-heavy mix.
+ * Adds roads between random cities and repairs random roads.
+ * @param map [in,out]     - pointer to map,
+ * @param network [in]     - pointer to network,
+ * @param ops [in]         - number of commands,
+ * @param rng [in,out]     - pointer to generator,
+ * @param result [in,out]  - pointer to results.
+ */
+static void runIngestMix(Map *map, network_t *network, unsigned ops,
+                         rng_t *rng, bench_result_t *result) {
+    for (unsigned i = 0; i < ops; i++) {
+        if (rangeRng(rng, 0, 9) < 6) {
+            bench_road_t road = {
+                    (unsigned) rangeRng(rng, 0, network->cities_num - 1),
+                    (unsigned) rangeRng(rng, 0, network->cities_num - 1),
+                    (unsigned) rangeRng(rng, 1, 100),
+                    (int) rangeRng(rng, 1950, 2020), false};
+            benchAddRoad(map, network, &road, result);
+        } else {
+            const bench_road_t *road =
+                    &network->roads[rangeRng(rng, 0, network->roads_num - 1)];
+            uint64_t start = getTimeNs();
+            bool ok = repairRoad(map, network->names[road->city1],
+                                 network->names[road->city2],
+                                 (int) rangeRng(rng, 2000, 2030));
+            recordCall(result, BENCH_REPAIR_ROAD, ok, start);
+        }
+    }
+}
+
+/** @brief Runs route-heavy mix.
+ * Creates, extends, reads and removes routes.
+ * @param map [in,out]     - pointer to map,
+ * @param network [in]     - pointer to network,
+ * @param ops [in]         - number of commands,
+ * @param rng [in,out]     - pointer to generator,
+ * @param result [in,out]  - pointer to results.
+ */
+static void runRouteMix(Map *map, network_t *network, unsigned ops,
+                        rng_t *rng, bench_result_t *result) {
+    for (unsigned i = 0; i < ops; i++) {
+        uint64_t kind = rangeRng(rng, 0, 9), start;
+        unsigned route = (unsigned) rangeRng(rng, 1, 999);
+        bool ok;
+
+        if (kind < 3) {
+            benchNewRoute(map, network, rng, result);
+        } else if (kind < 5) {
+            unsigned city = (unsigned) rangeRng(rng, 0,
+                                                network->cities_num - 1);
+            start = getTimeNs();
+            ok = extendRoute(map, route, network->names[city]);
+            recordCall(result, BENCH_EXTEND_ROUTE, ok, start);
+        } else if (kind < 9) {
+            benchGetRouteDescription(map, rng, result);
+        } else {
+            start = getTimeNs();
+            ok = removeRoute(map, route);
+            recordCall(result, BENCH_REMOVE_ROUTE, ok, start);
+        }
+    }
+}
+
+/** @brief Runs removal-heavy mix.
+ * Creates routes and then removes random roads, which forces searching
+ * diversions, adds removed roads back and reads routes.
+ * @param map [in,out]     - pointer to map,
+ * @param network [in]     - pointer to network,
+ * @param ops [in]         - number of commands,
+ * @param rng [in,out]     - pointer to generator,
+ * @param result [in,out]  - pointer to results.
+ */
+static void runRemovalMix(Map *map, network_t *network, unsigned ops,
+                          rng_t *rng, bench_result_t *result) {
+    size_t *removed = (size_t *) malloc(sizeof(size_t) * (ops + 1));
+    size_t removed_num = 0;
+
+    if (removed == NULL)
+        fail("out of memory");
+
+    for (unsigned i = 0; i < REMOVAL_ROUTES; i++)
+        benchNewRoute(map, network, rng, result);
+
+    for (unsigned i = 0; i < ops; i++) {
+        uint64_t kind = rangeRng(rng, 0, 9);
+
+        if (kind < 5) {
+            size_t index = rangeRng(rng, 0, network->roads_num - 1);
+            bench_road_t *road = &network->roads[index];
+            uint64_t start;
+            bool ok;
+
+            if (road->removed)
+                continue;
+            start = getTimeNs();
+            ok = removeRoad(map, network->names[road->city1],
+                            network->names[road->city2]);
+            recordCall(result, BENCH_REMOVE_ROAD, ok, start);
+            if (ok) {
+                road->removed = true;
+                removed[removed_num++] = index;
+            }
+        } else if (kind < 9 && removed_num > 0) {
+            size_t k = rangeRng(rng, 0, removed_num - 1);
+            bench_road_t *road = &network->roads[removed[k]];
+
+            if (benchAddRoad(map, network, road, result))
+                road->removed = false;
+            removed[k] = removed[--removed_num];
+        } else {
+            benchGetRouteDescription(map, rng, result);
+        }
+    }
+    free(removed);
+}
+
+/** @brief Prints results of benchmark.
+ * @param result [in]      - pointer to results.
+ */
+static void printResult(const bench_result_t *result) {
+    printf("%-20s %10s %10s %12s %10s %10s %10s %10s\n", "command", "calls",
+           "ok", "ops_per_s", "p50_ns", "p99_ns", "p999_ns", "max_ns");
+
+    for (int i = 0; i < BENCH_COMMANDS_NUM; i++) {
+        const histogram_t *latency = &result->latency[i];
+
+        if (latency->count == 0)
+            continue;
+        printf("%-20s %10llu %10llu %12.0f %10llu %10llu %10llu %10llu\n",
+               command_names[i], (unsigned long long) latency->count,
+               (unsigned long long) result->ok[i],
+               (double) latency->count * 1e9 / (double) latency->sum,
+               (unsigned long long) histogramPercentile(latency, 50),
+               (unsigned long long) histogramPercentile(latency, 99),
+               (unsigned long long) histogramPercentile(latency, 99.9),
+               (unsigned long long) latency->max);
+    }
+    printf("\n");
+}
+
+/** @brief Runs benchmark of one network and mix.
+ * Adds all roads of network to new map and runs mix of commands.
+ * @param network [in,out] - pointer to network,
+ * @param type [in]        - type of network,
+ * @param size [in]        - size of network,
+ * @param mix [in]         - mix of commands,
+ * @param options [in]     - pointer to options.
+ */
+static void runBenchmark(network_t *network, network_type_t type, size_t size,
+                         command_mix_t mix, const bench_options_t *options) {
+    bench_result_t *result = (bench_result_t *) malloc(sizeof(bench_result_t));
+    Map *map = newMap();
+    uint64_t start = getTimeNs();
+    rng_t rng;
+
+    if (result == NULL || map == NULL)
+        fail("out of memory");
+    for (int i = 0; i < BENCH_COMMANDS_NUM; i++) {
+        result->ok[i] = 0;
+        initHistogram(&result->latency[i]);
+    }
+    for (size_t i = 0; i < network->roads_num; i++)
+        network->roads[i].removed = false;
+
+    initRng(&rng, options->seed * 31 + (uint64_t) mix);
+    for (size_t i = 0; i < network->roads_num; i++)
+        benchAddRoad(map, network, &network->roads[i], result);
+
+    switch (mix) {
+        case MIX_INGEST:
+            runIngestMix(map, network, options->ops, &rng, result);
+            break;
+        case MIX_ROUTE:
+            runRouteMix(map, network, options->ops, &rng, result);
+            break;
+        default:
+            runRemovalMix(map, network, options->ops, &rng, result);
+            break;
+    }
+
+    printf("# network=%s size=%s cities=%u roads=%zu mix=%s seed=%llu "
+           "time_ms=%.1f\n", network_names[type], size_names[size],
+           network->cities_num, network->roads_num, mix_names[mix],
+           (unsigned long long) options->seed,
+           (double) (getTimeNs() - start) / 1e6);
+    printResult(result);
+    fflush(stdout);
+
+    deleteMap(map);
+    free(result);
+}
+
+/** @brief Selects names given as option argument.
+ * @param name [in]        - option argument, name or "all",
+ * @param names [in]       - array of names,
+ * @param names_num [in]   - number of names,
+ * @param selected [out]   - flags of selected names.
+ * @return Value @p true if argument is valid. Otherwise value @p false.
+ */
+static bool selectNames(const char *name, const char *const *names,
+                        size_t names_num, bool *selected) {
+    bool all = strcmp(name, "all") == 0, found = all;
+
+    for (size_t i = 0; i < names_num; i++) {
+        selected[i] = all || strcmp(name, names[i]) == 0;
+        found = found || selected[i];
+    }
+    return found;
+}
+
+/** @brief Prints usage of program.
+ * @param program [in]     - name of program.
+ */
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--seed N] [--ops N]"
+                    " [--network grid|geometric|scalefree|all]"
+                    " [--size small|medium|large|all]"
+                    " [--mix ingest|route|removal|all]\n"
+                    "By default all networks and mixes are run on small and"
+                    " medium networks.\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+            {"seed",    required_argument, NULL, 's'},
+            {"ops",     required_argument, NULL, 'o'},
+            {"network", required_argument, NULL, 'n'},
+            {"size",    required_argument, NULL, 'z'},
+            {"mix",     required_argument, NULL, 'm'},
+            {NULL, 0,                      NULL, 0}
+    };
+    bench_options_t options;
+    bool valid = true;
+    int option;
+
+    options.seed = 1;
+    options.ops = 2000;
+    selectNames("all", network_names, NETWORKS_NUM, options.networks);
+    selectNames("all", size_names, SIZES_NUM, options.sizes);
+    options.sizes[SIZES_NUM - 1] = false;
+    selectNames("all", mix_names, MIXES_NUM, options.mixes);
+
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 's':
+                options.seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'o':
+                options.ops = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                valid = selectNames(optarg, network_names, NETWORKS_NUM,
+                                    options.networks);
+                break;
+            case 'z':
+                valid = selectNames(optarg, size_names, SIZES_NUM,
+                                    options.sizes);
+                break;
+            case 'm':
+                valid = selectNames(optarg, mix_names, MIXES_NUM,
+                                    options.mixes);
+                break;
+            default:
+                valid = false;
+                break;
+        }
+        if (!valid)
+            break;
+    }
+    if (!valid || optind != argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    for (int type = 0; type < NETWORKS_NUM; type++) {
+        for (size_t size = 0; size < SIZES_NUM; size++) {
+            network_t network;
+
+            if (!options.networks[type] || !options.sizes[size])
+                continue;
+
+            generateNetwork(&network, (network_type_t) type, size_cities[size],
+                            options.seed * 1000003 + (uint64_t) type * 101 +
+                            (uint64_t) size);
+            for (int mix = 0; mix < MIXES_NUM; mix++) {
+                if (options.mixes[mix])
+                    runBenchmark(&network, (network_type_t) type, size,
+                                 (command_mix_t) mix, &options);
+            }
+            deleteNetwork(&network);
+        }
+    }
+    return 0;
+}
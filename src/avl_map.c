@@ -17,6 +17,7 @@
 #include <stdlib.h>
 
 #include "avl_map.h"
+#include "memory_stats.h"
 
 /** @brief Defines avl tree rotation left type.
  */
@@ -31,15 +32,16 @@
  * @return Pointer to new node or NULL if allocation error occurred.
  */
 static tree_t *createNode(void *key, void *value) {
-    tree_t *newNode = (tree_t *) malloc(sizeof(tree_t));
+    tree_t *newNode = (tree_t *) MEMORY_ALLOC(MEMORY_AVL, sizeof(tree_t));
 
     if (newNode == NULL)
         return NULL;
 
-    newNode->children = (tree_t **) malloc(2 * sizeof(tree_t *));
+    newNode->children = (tree_t **) MEMORY_ALLOC(MEMORY_AVL,
+                                                 2 * sizeof(tree_t *));
 
     if (newNode->children == NULL) {
-        free(newNode);
+        MEMORY_FREE(MEMORY_AVL, newNode);
         return NULL;
     }
 
@@ -225,7 +227,7 @@ static tree_t *avlDeleteNode(map_t *map, tree_t *tree, void *key, bool *removed,
             if (tmpNode == NULL) {
                 tmpNode = tree;
                 nodeObjectsDestroy(map, tree, type);
-                free(tree->children);
+                MEMORY_FREE(MEMORY_AVL, tree->children);
                 tree = NULL;
             } else {
                 nodeObjectsDestroy(map, tree, type);
@@ -233,9 +235,9 @@ static tree_t *avlDeleteNode(map_t *map, tree_t *tree, void *key, bool *removed,
                 tree->value = tmpNode->value;
                 tree->children[0] = tmpNode->children[0];
                 tree->children[1] = tmpNode->children[1];
-                free(tmpNode->children);
+                MEMORY_FREE(MEMORY_AVL, tmpNode->children);
             }
-            free(tmpNode);
+            MEMORY_FREE(MEMORY_AVL, tmpNode);
         } else {
             // Finding node with minimum value in right sub-tree
             tmpNode = findMinKeyNode(tree->children[1]);
@@ -304,11 +306,11 @@ static void avlDelete(map_t *map, tree_t *tree, int type) {
     if (tree->children[1] != NULL)
         avlDelete(map, tree->children[1], type);
 
-    free(tree->children);
+    MEMORY_FREE(MEMORY_AVL, tree->children);
 
     nodeObjectsDestroy(map, tree, type);
 
-    free(tree);
+    MEMORY_FREE(MEMORY_AVL, tree);
 }
 
 /** @brief Prints all keys in weak order.
@@ -359,6 +361,52 @@ static void avlGetValuesList(tree_t *tree, list_t **head, bool *error) {
         avlGetValuesList(tree->children[0], head, error);
 }
 
+/** @brief Counts nodes in given tree.
+ * @param tree [in, out]   - pointer to tree.
+ * @return Number of nodes in tree.
+ */
+static size_t avlCountNodes(tree_t *tree) {
+    if (tree == NULL)
+        return 0;
+    return 1 + avlCountNodes(tree->children[0]) +
+           avlCountNodes(tree->children[1]);
+}
+
+/** @brief Stores nodes of given tree in array in weak ordering.
+ * @param tree [in, out]   - pointer to tree;
+ * @param nodes [out]      - array of nodes;
+ * @param pos [in, out]    - position of next stored node.
+ */
+static void avlCollectNodes(tree_t *tree, tree_t **nodes, size_t *pos) {
+    if (tree == NULL)
+        return;
+    avlCollectNodes(tree->children[0], nodes, pos);
+    nodes[(*pos)++] = tree;
+    avlCollectNodes(tree->children[1], nodes, pos);
+}
+
+/** @brief Builds perfectly balanced tree from nodes sorted in weak ordering.
+ * @param nodes [in, out]  - array of nodes;
+ * @param begin [in]       - position of first node;
+ * @param end [in]         - position after last node.
+ * @return Pointer to root of built tree.
+ */
+static tree_t *avlBuildFromSorted(tree_t **nodes, size_t begin, size_t end) {
+    size_t mid;
+    tree_t *root;
+
+    if (begin == end)
+        return NULL;
+
+    mid = begin + (end - begin) / 2;
+    root = nodes[mid];
+    root->children[0] = avlBuildFromSorted(nodes, begin, mid);
+    root->children[1] = avlBuildFromSorted(nodes, mid + 1, end);
+    updateTreeHeight(root);
+
+    return root;
+}
+
 /** @brief Initiates empty map with given comparator.
  * When any pair <key, value> is removed or map is deleted, given destructors
  * are used if deletion type requires it.
@@ -372,7 +420,7 @@ static void avlGetValuesList(tree_t *tree, list_t **head, bool *error) {
 map_t *mapInit(bool (*compare)(void *, void *), bool (*equals)(void *, void *),
                void (*printer)(void *), void (*keyDestructor)(void *),
                void (*valueDestructor)(void *)) {
-    map_t *newMap = (map_t *) malloc(sizeof(map_t));
+    map_t *newMap = (map_t *) MEMORY_ALLOC(MEMORY_AVL, sizeof(map_t));
 
     if (newMap == NULL)
         return NULL;
@@ -475,7 +523,7 @@ void mapDelete(map_t *map, int type) {
     if (map->root != NULL)
         avlDelete(map, map->root, type);
 
-    free(map);
+    MEMORY_FREE(MEMORY_AVL, map);
 }
 
 /** @brief Prints keys to standard output using given printer in weak ordering.
@@ -554,4 +602,72 @@ void mapClear(map_t *map, int type) {
     avlDelete(map, map->root, type);
 
     map->root = NULL;
-}
\ No newline at end of file
+}
+
+/** @brief Inserts many pairs <key, value> to map at once.
+ * Assumes that keys are sorted in weak ordering and none of them is already
+ * stored in map. Instead of inserting pairs one by one, merges them with
+ * pairs already stored in map and builds balanced tree bottom-up.
+ * Map isn't modified if allocation error occurred.
+ * @param map [in, out]   - pointer to map;
+ * @param keys [in]       - array of keys;
+ * @param values [in]     - array of values;
+ * @param n [in]          - number of pairs.
+ * @return Value @p true if pairs were inserted, value @p false
+ * if allocation error occurred.
+ */
+bool mapBulkInsert(map_t *map, void **keys, void **values, size_t n) {
+    size_t old_n, i, j, k;
+    tree_t **old_nodes, **nodes;
+
+    if (map == NULL)
+        return false;
+    if (n == 0)
+        return true;
+
+    old_n = avlCountNodes(map->root);
+    old_nodes = (tree_t **) MEMORY_ALLOC(MEMORY_AVL,
+                                         sizeof(tree_t *) * (old_n + 1));
+    nodes = (tree_t **) MEMORY_ALLOC(MEMORY_AVL,
+                                     sizeof(tree_t *) * (old_n + n));
+    if (old_nodes == NULL || nodes == NULL) {
+        MEMORY_FREE(MEMORY_AVL, old_nodes);
+        MEMORY_FREE(MEMORY_AVL, nodes);
+        return false;
+    }
+
+    // Creating new nodes in place of merged array's tail.
+    for (k = 0; k < n; k++) {
+        nodes[old_n + k] = createNode(keys[k], values[k]);
+        if (nodes[old_n + k] == NULL) {
+            while (k > 0) {
+                k--;
+                MEMORY_FREE(MEMORY_AVL, nodes[old_n + k]->children);
+                MEMORY_FREE(MEMORY_AVL, nodes[old_n + k]);
+            }
+            MEMORY_FREE(MEMORY_AVL, old_nodes);
+            MEMORY_FREE(MEMORY_AVL, nodes);
+            return false;
+        }
+    }
+
+    k = 0;
+    avlCollectNodes(map->root, old_nodes, &k);
+
+    // Merging old and new nodes, new nodes are moved only forward.
+    i = 0;
+    j = old_n;
+    for (k = 0; k < old_n + n; k++) {
+        if (j == old_n + n ||
+            (i < old_n && map->compare(old_nodes[i]->key, nodes[j]->key)))
+            nodes[k] = old_nodes[i++];
+        else
+            nodes[k] = nodes[j++];
+    }
+
+    map->root = avlBuildFromSorted(nodes, 0, old_n + n);
+
+    MEMORY_FREE(MEMORY_AVL, old_nodes);
+    MEMORY_FREE(MEMORY_AVL, nodes);
+    return true;
+}
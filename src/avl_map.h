@@ -136,4 +136,18 @@ list_t *mapGetValuesList(map_t *map);
  */
 void mapClear(map_t *map, int type);
 
+/** @brief Inserts many pairs <key, value> to map at once.
+ * Assumes that keys are sorted in weak ordering and none of them is already
+ * stored in map. Instead of inserting pairs one by one, merges them with
+ * pairs already stored in map and builds balanced tree bottom-up.
+ * Map isn't modified if allocation error occurred.
+ * @param map [in, out]   - pointer to map;
+ * @param keys [in]       - array of keys;
+ * @param values [in]     - array of values;
+ * @param n [in]          - number of pairs.
+ * @return Value @p true if pairs were inserted, value @p false
+ * if allocation error occurred.
+ */
+bool mapBulkInsert(map_t *map, void **keys, void **values, size_t n);
+
 #endif //MALE_AVL_MAP_H
@@ -0,0 +1,172 @@
+/** @file
+ * Implementation of module finding bridges in map of roads.
+ * Bridges are found by depth first search, which computes for every city
+ * lowest entry time reachable from its subtree. Tree road leading to city is
+ * bridge if its subtree can't reach any earlier city.
+ * Flags are kept in roads and recomputed only for component of road, which
+ * diversion wasn't found, so successful removals never pay for search.
+ * Every change of map gets new stamp and every city remembers stamp of last
+ * search of its component, so flags of city roads are exact if stamps are
+ * equal. Removing roads can't make bridge connected by other way, so flag
+ * of bridge stays true until road closing cycle is added.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <stdlib.h>
+
+#include "bridges.h"
+#include "city.h"
+#include "memory_stats.h"
+#include "road.h"
+#include "search_stats.h"
+
+/**
+ * Structure representing state of city in depth first search.
+ */
+typedef struct bridge_state {
+    unsigned entry;             /**< Entry time, 0 if city wasn't visited. */
+    unsigned low;               /**< Lowest entry time reachable from
+                                     subtree of city. */
+    unsigned next_road;         /**< Position of next road to visit. */
+    Road *parent_road;          /**< Tree road leading to city. */
+} bridge_state_t;
+
+/** @brief Finds bridges in component of city.
+ * Sets bridge flag of every road in component. Uses explicit stack, so long
+ * chains of roads don't overflow call stack.
+ * @param map [in,out]     - pointer to map,
+ * @param root [in,out]    - pointer to city.
+ * @return Value @p true if flags were set. Value @p false if allocation
+ * error occurred, then flags stay stale.
+ */
+static bool findBridgesInComponent(Map *map, City *root) {
+    bridge_state_t *states;
+    City **stack;
+    unsigned stack_size = 0, time = 0;
+
+    states = (bridge_state_t *) MEMORY_CALLOC(MEMORY_MAP, map->cities_num,
+                                              sizeof(bridge_state_t));
+    if (states == NULL)
+        return false;
+    stack = (City **) MEMORY_ALLOC(MEMORY_MAP,
+                                   sizeof(City *) * map->cities_num);
+    if (stack == NULL) {
+        MEMORY_FREE(MEMORY_MAP, states);
+        return false;
+    }
+
+    states[root->id].entry = states[root->id].low = ++time;
+    root->bridges_stamp = map->bridges_stamp;
+    stack[stack_size++] = root;
+    while (stack_size > 0) {
+        City *curr_city = stack[stack_size - 1];
+        bridge_state_t *curr = &states[curr_city->id];
+
+        if (curr->next_road < curr_city->roads_num) {
+            Road *road = curr_city->roads[curr->next_road++];
+            City *next_city = getNextCity(curr_city, road);
+            bridge_state_t *next = &states[next_city->id];
+
+            if (road == curr->parent_road)
+                continue;
+            if (next->entry == 0) {
+                next->entry = next->low = ++time;
+                next->parent_road = road;
+                next_city->bridges_stamp = map->bridges_stamp;
+                stack[stack_size++] = next_city;
+            } else {
+                road->bridge = false;
+                if (next->entry < curr->low)
+                    curr->low = next->entry;
+            }
+            continue;
+        }
+
+        stack_size--;
+        if (curr->parent_road != NULL) {
+            bridge_state_t *parent =
+                    &states[getNextCity(curr_city, curr->parent_road)->id];
+
+            if (curr->low < parent->low)
+                parent->low = curr->low;
+            curr->parent_road->bridge = curr->low > parent->entry;
+        }
+    }
+
+    MEMORY_FREE(MEMORY_MAP, stack);
+    MEMORY_FREE(MEMORY_MAP, states);
+    SEARCH_STATS_ADD(bridge_scans, 1);
+    return true;
+}
+
+/** @brief Checks if road is known to be bridge without any search.
+ * Stale flag of road which isn't bridge isn't searched again, so road can
+ * be bridge even if it isn't known.
+ * @param map [in]         - pointer to map,
+ * @param road [in]        - pointer to road.
+ * @return Value @p true if flag of road is exact and set or road was bridge
+ * and only roads were removed since. Otherwise value @p false.
+ */
+bool checkIfRoadIsKnownBridge(Map *map, Road *road) {
+    return road->bridge &&
+           road->city1->bridges_stamp >= map->bridges_cycle_stamp;
+}
+
+/** @brief Updates bridges after diversion around road wasn't found.
+ * Road without diversion is often bridge, so bridges in its component are
+ * found again if its flag can be stale. Next removals of bridges of this
+ * component are then rejected without search. If allocation error occurs,
+ * flags stay stale.
+ * @param map [in,out]     - pointer to map,
+ * @param road [in]        - pointer to road.
+ */
+void updateBridgesAfterMissingDiversion(Map *map, Road *road) {
+    if (road->city1->bridges_stamp != map->bridges_stamp)
+        findBridgesInComponent(map, road->city1);
+}
+
+/** @brief Updates bridges after adding road to map.
+ * Road leading to new city is bridge and doesn't change other roads, so
+ * new city gets stamp of second city. Road between existing cities can
+ * close cycle, so flags of all roads become stale.
+ * @param map [in,out]     - pointer to map,
+ * @param road [in,out]    - pointer to added road,
+ * @param new_city1 [in]   - flag indicating if first city of road is new,
+ * @param new_city2 [in]   - flag indicating if second city of road is new.
+ */
+void updateBridgesAfterAddingRoad(Map *map, Road *road, bool new_city1,
+                                  bool new_city2) {
+    if (new_city1 && new_city2) {
+        road->city1->bridges_stamp = road->city2->bridges_stamp =
+                map->bridges_stamp;
+    } else if (new_city1) {
+        road->city1->bridges_stamp = road->city2->bridges_stamp;
+    } else if (new_city2) {
+        road->city2->bridges_stamp = road->city1->bridges_stamp;
+    } else {
+        invalidateBridges(map);
+        return;
+    }
+    road->bridge = true;
+}
+
+/** @brief Updates bridges before removing road from map.
+ * Removing bridge doesn't change any cycle, so other flags stay exact.
+ * Removing other road can make other roads bridges, but bridges stay
+ * bridges.
+ * @param map [in,out]     - pointer to map,
+ * @param road [in]        - pointer to removed road.
+ */
+void updateBridgesBeforeRemovingRoad(Map *map, Road *road) {
+    if (!checkIfRoadIsKnownBridge(map, road))
+        map->bridges_stamp++;
+}
+
+/** @brief Marks that bridge flags of all roads are stale.
+ * @param map [in,out]     - pointer to map.
+ */
+void invalidateBridges(Map *map) {
+    map->bridges_cycle_stamp = ++map->bridges_stamp;
+}
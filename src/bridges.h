@@ -0,0 +1,28 @@
+/** @file
+ * Interface of module finding bridges in map of roads.
+ * Road is bridge if removing it disconnects its cities. No diversion exists
+ * for such road, so it can't be removed while any route contains it.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_BRIDGES_H
+#define ROADS_BRIDGES_H
+
+#include <stdbool.h>
+
+#include "roads_types.h"
+
+bool checkIfRoadIsKnownBridge(Map *map, Road *road);
+
+void updateBridgesAfterMissingDiversion(Map *map, Road *road);
+
+void updateBridgesAfterAddingRoad(Map *map, Road *road, bool new_city1,
+                                  bool new_city2);
+
+void updateBridgesBeforeRemovingRoad(Map *map, Road *road);
+
+void invalidateBridges(Map *map);
+
+#endif //ROADS_BRIDGES_H
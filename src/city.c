@@ -6,19 +6,76 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "city.h"
-#include "utils.h"
+#include "memory_stats.h"
 #include "road.h"
 
-/** @brief Returns name of second city connected by road.
- * @param city [in,out] - pointer to city,
- * @param road [in,out] - pointer to road.
- * @return Name of second city connected by road.
+/** @brief Finds position of road leading to specified city.
+ * Roads in city are sorted by number of second city. Small arrays are
+ * scanned linearly, larger ones using binary search.
+ * @param city [in]      - pointer to city,
+ * @param next_id [in]   - number of second city,
+ * @param found [out]    - flag indicating if road was found.
+ * @return Position of road leading to city with number @p next_id or
+ * position where such road should be inserted.
  */
-static char *getNextCityName(City *city, Road *road) {
-    City *next_city = getNextCity(city, road);
-    return next_city == NULL ? NULL : next_city->name;
+static unsigned findRoadPosition(City *city, unsigned next_id, bool *found) {
+    unsigned left = 0, right = city->roads_num, mid, curr_id;
+
+    *found = false;
+    if (city->roads_num <= CITY_INLINE_ROADS) {
+        for (left = 0; left < city->roads_num; left++) {
+            curr_id = getNextCity(city, city->roads[left])->id;
+            if (curr_id >= next_id) {
+                *found = curr_id == next_id;
+                break;
+            }
+        }
+        return left;
+    }
+
+    while (left < right) {
+        mid = left + (right - left) / 2;
+        curr_id = getNextCity(city, city->roads[mid])->id;
+        if (curr_id == next_id) {
+            *found = true;
+            return mid;
+        }
+        if (curr_id < next_id)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+    return left;
+}
+
+/** @brief Enlarges array of outgoing roads.
+ * Moves roads from inline array to heap if necessary.
+ * @param city [in,out]     - pointer to city,
+ * @param capacity [in]     - new size of array.
+ * @return Value @p true if array was enlarged. Otherwise value @p false.
+ */
+static bool resizeRoadsArray(City *city, unsigned capacity) {
+    Road **new_roads;
+
+    if (city->roads == city->inline_roads) {
+        new_roads = (Road **) MEMORY_ALLOC(MEMORY_CITY,
+                                           sizeof(Road *) * capacity);
+        if (new_roads == NULL)
+            return false;
+        memcpy(new_roads, city->inline_roads, sizeof(Road *) * city->roads_num);
+    } else {
+        new_roads = (Road **) MEMORY_REALLOC(MEMORY_CITY, city->roads,
+                                             sizeof(Road *) * capacity);
+        if (new_roads == NULL)
+            return false;
+    }
+
+    city->roads = new_roads;
+    city->roads_capacity = capacity;
+    return true;
 }
 
 /** @brief City destructor used only by avl_map module.
@@ -29,46 +86,62 @@ void deleteCityFromAvlMap(void *city) {
 }
 
 /** @brief Creates city.
- * @param name [in]     - pointer to city name.
+ * @param name [in]     - handle of city name,
+ * @param id [in]       - city number, unique in map.
  * @return Pointer to new city or NULL if allocation error occurred.
  */
-City *createCity(char *name) {
-    City *new_city = (City *) malloc(sizeof(City));
+City *createCity(const char *name, unsigned id) {
+    City *new_city = (City *) MEMORY_ALLOC(MEMORY_CITY, sizeof(City));
 
     if (new_city == NULL)
         return NULL;
 
-    new_city->connected_roads = mapInit(cityNameCmp, cityNameEq, printCityName,
-                                        free, deleteRoadFromAvlMap);
-    if (new_city->connected_roads == NULL) {
-        free(new_city);
-        return NULL;
-    }
-
     new_city->name = name;
+    new_city->id = id;
+    new_city->roads_num = 0;
+    new_city->roads_capacity = CITY_INLINE_ROADS;
+    new_city->roads = new_city->inline_roads;
+    new_city->bridges_stamp = 0;
     return new_city;
 }
 
 /** @brief Deletes city.
+ * Deletes also roads, which second city was already deleted. City name
+ * is owned by pool of names, so it isn't freed.
  * @param city [in]     - pointer to city.
  */
 void deleteCity(City *city) {
     if (city == NULL)
         return;
-    free(city->name);
-    mapDelete(city->connected_roads, 2);
-    free(city);
+    for (unsigned i = 0; i < city->roads_num; i++)
+        safeDeleteRoad(city->roads[i]);
+    if (city->roads != city->inline_roads)
+        MEMORY_FREE(MEMORY_CITY, city->roads);
+    MEMORY_FREE(MEMORY_CITY, city);
 }
 
 /** @brief Adds road to city.
+ * Do nothing if city has already road to the same city.
  * @param city [in,out] - pointer to city,
  * @param road [in]     - pointer to road.
- * @return Value @p true if road was added. Otherwise value @p false.
+ * @return Value @p true if road was added or already exists.
+ * Otherwise value @p false.
  */
 bool addRoadToCity(City *city, Road *road) {
-    char *next_city_name = getNextCityName(city, road);
-    return mapInsert(city->connected_roads, (void *) next_city_name,
-                     (void *) road);
+    bool found;
+    unsigned pos = findRoadPosition(city, getNextCity(city, road)->id, &found);
+
+    if (found)
+        return true;
+    if (city->roads_num == city->roads_capacity &&
+        !resizeRoadsArray(city, 2 * city->roads_capacity))
+        return false;
+
+    memmove(city->roads + pos + 1, city->roads + pos,
+            sizeof(Road *) * (city->roads_num - pos));
+    city->roads[pos] = road;
+    city->roads_num++;
+    return true;
 }
 
 /** @brief Removes road from city.
@@ -77,6 +150,65 @@ bool addRoadToCity(City *city, Road *road) {
  * @param road [in]     - pointer to road.
  */
 void removeRoadFromCity(City *city, Road *road) {
-    char *next_city_name = getNextCityName(city, road);
-    mapRemove(city->connected_roads, (void *) next_city_name, 0);
-}
\ No newline at end of file
+    bool found;
+    unsigned pos = findRoadPosition(city, getNextCity(city, road)->id, &found);
+
+    if (!found)
+        return;
+
+    city->roads_num--;
+    memmove(city->roads + pos, city->roads + pos + 1,
+            sizeof(Road *) * (city->roads_num - pos));
+}
+
+/** @brief Finds road connecting two cities.
+ * @param city [in,out]      - pointer to first city,
+ * @param next_city [in,out] - pointer to second city.
+ * @return Pointer to road or NULL if cities aren't connected.
+ */
+Road *getRoadToCity(City *city, City *next_city) {
+    bool found;
+    unsigned pos = findRoadPosition(city, next_city->id, &found);
+
+    return found ? city->roads[pos] : NULL;
+}
+
+/** @brief Ensures that city can store specified number of roads.
+ * @param city [in,out]     - pointer to city,
+ * @param roads_num [in]    - number of roads.
+ * @return Value @p true if city can store @p roads_num roads.
+ * Otherwise value @p false.
+ */
+bool reserveRoadsInCity(City *city, unsigned roads_num) {
+    unsigned capacity = city->roads_capacity;
+
+    if (roads_num <= capacity)
+        return true;
+    while (capacity < roads_num)
+        capacity *= 2;
+    return resizeRoadsArray(city, capacity);
+}
+
+/** @brief Adds many roads to city at once.
+ * Assumes that roads are sorted by number of second city, city doesn't have
+ * any of them yet and space for them was reserved using
+ * @ref reserveRoadsInCity.
+ * @param city [in,out]     - pointer to city,
+ * @param roads [in]        - array of roads,
+ * @param roads_num [in]    - number of roads.
+ */
+void mergeRoadsIntoCity(City *city, Road **roads, unsigned roads_num) {
+    unsigned old_pos = city->roads_num, new_pos = roads_num;
+    unsigned pos = city->roads_num + roads_num;
+
+    // Merging from the end, so no roads are overwritten.
+    while (new_pos > 0) {
+        if (old_pos > 0 &&
+            getNextCity(city, city->roads[old_pos - 1])->id >
+            getNextCity(city, roads[new_pos - 1])->id)
+            city->roads[--pos] = city->roads[--old_pos];
+        else
+            city->roads[--pos] = roads[--new_pos];
+    }
+    city->roads_num += roads_num;
+}
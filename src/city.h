@@ -12,7 +12,7 @@
 
 void deleteCityFromAvlMap(void *city);
 
-City *createCity(char *name);
+City *createCity(const char *name, unsigned id);
 
 void deleteCity(City *city);
 
@@ -20,4 +20,10 @@ bool addRoadToCity(City *city, Road *road);
 
 void removeRoadFromCity(City *city, Road *road);
 
+Road *getRoadToCity(City *city, City *next_city);
+
+bool reserveRoadsInCity(City *city, unsigned roads_num);
+
+void mergeRoadsIntoCity(City *city, Road **roads, unsigned roads_num);
+
 #endif //ROADS_CITY_H
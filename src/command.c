@@ -0,0 +1,567 @@
+/** @file
+ * Implementation of parsed text interface commands.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "command.h"
+#include "memory_stats.h"
+#include "utils.h"
+
+/**
+ * Macro defining perfect hash of command name, computed from its first, third
+ * and last character and its length. Hashes of all command names are
+ * different, collision is reported by compiler as overridden initializer.
+ */
+#define COMMAND_HASH(first, third, last, len) \
+    (((unsigned) (first) + (unsigned) (third) + (unsigned) (last) + \
+      3 * (unsigned) (len)) & 63)
+
+/**
+ * Structure describing command name.
+ */
+typedef struct command_name {
+    const char *name;           /**< Command name. */
+    size_t len;                 /**< Length of command name. */
+    command_type_t type;        /**< Type of command. */
+} command_name_t;
+
+/**
+ * Table of command names indexed by @ref COMMAND_HASH.
+ */
+static const command_name_t command_names[64] = {
+        [COMMAND_HASH('a', 'd', 'd', 7)] =
+                {"addRoad", 7, COMMAND_ADD_ROAD},
+        [COMMAND_HASH('r', 'p', 'd', 10)] =
+                {"repairRoad", 10, COMMAND_REPAIR_ROAD},
+        [COMMAND_HASH('g', 't', 'n', 19)] =
+                {"getRouteDescription", 19, COMMAND_GET_ROUTE_DESCRIPTION},
+        [COMMAND_HASH('n', 'w', 'e', 8)] =
+                {"newRoute", 8, COMMAND_NEW_ROUTE},
+        [COMMAND_HASH('e', 't', 'e', 11)] =
+                {"extendRoute", 11, COMMAND_EXTEND_ROUTE},
+        [COMMAND_HASH('r', 'm', 'd', 10)] =
+                {"removeRoad", 10, COMMAND_REMOVE_ROAD},
+        [COMMAND_HASH('a', 'a', 'd', 17)] =
+                {"analyzeRemoveRoad", 17, COMMAND_ANALYZE_REMOVE_ROAD},
+        [COMMAND_HASH('r', 'm', 'e', 11)] =
+                {"removeRoute", 11, COMMAND_REMOVE_ROUTE},
+        [COMMAND_HASH('s', 'o', 'h', 12)] =
+                {"shortestPath", 12, COMMAND_SHORTEST_PATH},
+        [COMMAND_HASH('d', 's', 'x', 14)] =
+                {"distanceMatrix", 14, COMMAND_DISTANCE_MATRIX},
+        [COMMAND_HASH('r', 'a', 'e', 9)] =
+                {"reachable", 9, COMMAND_REACHABLE},
+        [COMMAND_HASH('k', 'h', 's', 14)] =
+                {"kShortestPaths", 14, COMMAND_K_SHORTEST_PATHS},
+        [COMMAND_HASH('p', 'r', 's', 11)] =
+                {"paretoPaths", 11, COMMAND_PARETO_PATHS},
+        [COMMAND_HASH('s', 'o', 'e', 17)] =
+                {"shortestPathSince", 17, COMMAND_SHORTEST_PATH_SINCE},
+        [COMMAND_HASH('o', 'd', 's', 11)] =
+                {"oldestRoads", 11, COMMAND_OLDEST_ROADS},
+        [COMMAND_HASH('r', 'a', 'n', 14)] =
+                {"roadsOlderThan", 14, COMMAND_ROADS_OLDER_THAN},
+        [COMMAND_HASH('r', 'u', 'd', 15)] =
+                {"routeOldestRoad", 15, COMMAND_ROUTE_OLDEST_ROAD},
+        [COMMAND_HASH('b', 'g', 'd', 13)] =
+                {"beginBulkLoad", 13, COMMAND_BEGIN_BULK_LOAD},
+        [COMMAND_HASH('e', 'd', 'd', 11)] =
+                {"endBulkLoad", 11, COMMAND_END_BULK_LOAD},
+        [COMMAND_HASH('f', 'u', 'h', 5)] =
+                {"flush", 5, COMMAND_FLUSH},
+        [COMMAND_HASH('s', 'a', 's', 5)] =
+                {"stats", 5, COMMAND_STATS},
+};
+
+/** @brief Finds type of command with given name.
+ * @param name [in]        - pointer to name,
+ * @param len [in]         - length of name.
+ * @return Type of command or @ref COMMAND_INVALID if there is no command
+ * with given name.
+ */
+static command_type_t findCommandType(const char *name, size_t len) {
+    const command_name_t *entry;
+
+    if (len < 3)
+        return COMMAND_INVALID;
+
+    entry = &command_names[COMMAND_HASH((unsigned char) name[0],
+                                        (unsigned char) name[2],
+                                        (unsigned char) name[len - 1], len)];
+    if (entry->name != NULL && entry->len == len &&
+        memcmp(entry->name, name, len) == 0)
+        return entry->type;
+    return COMMAND_INVALID;
+}
+
+/** @brief Checks if scanned line ends with ';'.
+ * @param command [in]     - pointer to scanned command.
+ * @return Value @p true if line ends with ';'. Otherwise value @p false.
+ */
+static bool isSemicolonLast(const command_t *command) {
+    const line_scan_t *scan = &command->scan;
+
+    return scan->marks_num > 0 &&
+           scan->marks[scan->marks_num - 1] + 1 == scan->len &&
+           command->text[scan->len - 1] == ';';
+}
+
+/** @brief Adds field to fields of command.
+ * @param command [in,out] - pointer to command,
+ * @param text [in]        - pointer to field,
+ * @param len [in]         - length of field,
+ * @param clean [in]       - flag indicating if field has no control
+ *                           characters.
+ * @return Value @p true if field was added. Value @p false if allocation
+ * error occurred.
+ */
+static bool addField(command_t *command, char *text, size_t len, bool clean) {
+    if (command->fields_num == command->fields_capacity) {
+        size_t new_capacity = command->fields_capacity == 0
+                              ? 16 : 2 * command->fields_capacity;
+        field_t *new_fields = (field_t *) MEMORY_REALLOC(
+                MEMORY_PARSER, command->fields,
+                sizeof(field_t) * new_capacity);
+        if (new_fields == NULL)
+            return false;
+        command->fields = new_fields;
+        command->fields_capacity = new_capacity;
+    }
+
+    command->fields[command->fields_num].text = text;
+    command->fields[command->fields_num].len = len;
+    command->fields[command->fields_num].clean = clean;
+    command->fields_num++;
+    return true;
+}
+
+/** @brief Splits scanned line into fields.
+ * Uses marks found by scanner, so line isn't scanned again. Like strtok,
+ * replaces semicolons with '\0' and skips empty fields.
+ * @param command [in,out] - pointer to scanned command.
+ * @return Value @p true if line was split. Value @p false if allocation
+ * error occurred.
+ */
+static bool splitFields(command_t *command) {
+    const line_scan_t *scan = &command->scan;
+    char *line = command->text;
+    size_t begin = 0, end;
+    bool clean = true;
+
+    command->fields_num = 0;
+    line[scan->len] = '\0';
+
+    for (size_t i = 0; i <= scan->marks_num; i++) {
+        end = i < scan->marks_num ? scan->marks[i] : scan->len;
+        if (i < scan->marks_num && line[end] != ';') {
+            clean = false;
+            continue;
+        }
+        if (end > begin) {
+            line[end] = '\0';
+            if (!addField(command, line + begin, end - begin, clean))
+                return false;
+        }
+        begin = end + 1;
+        clean = true;
+    }
+    return true;
+}
+
+/** @brief Adds road to roads of created route.
+ * @param command [in,out] - pointer to command,
+ * @param params [in]      - city1, length, year and city2 of road.
+ * @return Value @p true if road was added. Value @p false if allocation
+ * error occurred.
+ */
+static bool addRouteRoad(command_t *command, const field_t *params) {
+    if (command->roads_num == command->roads_capacity) {
+        size_t new_capacity = command->roads_capacity == 0
+                              ? 16 : 2 * command->roads_capacity;
+        road_desc_t *new_roads = (road_desc_t *) MEMORY_REALLOC(
+                MEMORY_PARSER, command->roads,
+                sizeof(road_desc_t) * new_capacity);
+        if (new_roads == NULL)
+            return false;
+        command->roads = new_roads;
+        command->roads_capacity = new_capacity;
+    }
+
+    command->roads[command->roads_num].city1 = params[0].text;
+    command->roads[command->roads_num].length = parseStringToUnsigned(
+            params[1].text);
+    command->roads[command->roads_num].year = parseStringToInt(
+            params[2].text);
+    command->roads[command->roads_num].city2 = params[3].text;
+    command->roads_num++;
+    return true;
+}
+
+/** @brief Parses route description creating route.
+ * Description is in format like in @ref getRouteDescription. Route is invalid
+ * if any city is repeated, any name is invalid or description doesn't
+ * make path.
+ * @param command [in,out] - pointer to command split into fields.
+ */
+static void parseCreateRoute(command_t *command) {
+    const field_t *params = command->fields + 1;
+    size_t params_num = command->fields_num - 1;
+    map_t *cities_name;
+
+    if (params_num < 4 || (params_num - 1) % 3 != 0) {
+        command->valid = false;
+        return;
+    }
+
+    cities_name = mapInit(cityNameCmp, cityNameEq, printCityName, free, free);
+    if (cities_name == NULL) {
+        command->type = COMMAND_CRITICAL_ERROR;
+        return;
+    }
+
+    for (size_t i = 0; i < params_num; i += 3) {
+        if (!params[i].clean ||
+            mapContains(cities_name, (void *) params[i].text)) {
+            command->valid = false;
+            break;
+        }
+        if (!mapInsert(cities_name, (void *) params[i].text, "")) {
+            command->type = COMMAND_CRITICAL_ERROR;
+            break;
+        }
+        if (i + 3 < params_num && !addRouteRoad(command, params + i)) {
+            command->type = COMMAND_CRITICAL_ERROR;
+            break;
+        }
+    }
+
+    mapDelete(cities_name, 0);
+}
+
+/** @brief Parses arguments of distanceMatrix command.
+ * Arguments are number of sources N, N names of sources and at least one
+ * name of target. Names are only checked for control characters.
+ * @param command [in,out] - pointer to command split into fields.
+ */
+static void parseDistanceMatrix(command_t *command) {
+    const field_t *args = command->fields + 1;
+    size_t args_num = command->fields_num - 1;
+
+    command->valid = args_num >= 3;
+    if (!command->valid)
+        return;
+    command->sources_num = parseStringToUnsigned(args[0].text);
+    command->valid = command->sources_num > 0 &&
+                     command->sources_num < args_num - 1;
+    if (!command->valid)
+        return;
+
+    if (args_num - 1 > command->names_capacity) {
+        size_t new_capacity = command->names_capacity == 0
+                              ? 16 : command->names_capacity;
+        const char **new_names;
+
+        while (new_capacity < args_num - 1)
+            new_capacity *= 2;
+        new_names = (const char **) MEMORY_REALLOC(
+                MEMORY_PARSER, command->names,
+                sizeof(const char *) * new_capacity);
+        if (new_names == NULL) {
+            command->type = COMMAND_CRITICAL_ERROR;
+            return;
+        }
+        command->names = new_names;
+        command->names_capacity = new_capacity;
+    }
+
+    for (size_t i = 1; i < args_num; i++) {
+        if (!args[i].clean) {
+            command->valid = false;
+            return;
+        }
+        command->names[command->names_num++] = args[i].text;
+    }
+}
+
+/** @brief Parses road line inside bulk load block.
+ * Line has format city1;city2;length;builtYear. City names aren't checked,
+ * they are checked when block is added.
+ * @param command [in,out] - pointer to scanned command.
+ */
+static void parseBulkRoad(command_t *command) {
+    command->type = COMMAND_BULK_ROAD;
+    if (isSemicolonLast(command)) {
+        command->valid = false;
+        return;
+    }
+    if (!splitFields(command)) {
+        command->type = COMMAND_CRITICAL_ERROR;
+        return;
+    }
+    if (command->fields_num != 4) {
+        command->valid = false;
+        return;
+    }
+    command->cities[0] = command->fields[0].text;
+    command->cities[1] = command->fields[1].text;
+    command->length = parseStringToUnsigned(command->fields[2].text);
+    command->year = parseStringToInt(command->fields[3].text);
+}
+
+/** @brief Parses arguments of command with fixed number of arguments.
+ * City names are invalid if they contain control characters, so invalid
+ * commands don't reach map.
+ * @param command [in,out] - pointer to command split into fields.
+ */
+static void parseArguments(command_t *command) {
+    const field_t *args = command->fields + 1;
+    size_t args_num = command->fields_num - 1;
+
+    switch (command->type) {
+        case COMMAND_ADD_ROAD:
+            command->valid = args_num == 4 && args[0].clean && args[1].clean;
+            if (command->valid) {
+                command->cities[0] = args[0].text;
+                command->cities[1] = args[1].text;
+                command->length = parseStringToUnsigned(args[2].text);
+                command->year = parseStringToInt(args[3].text);
+            }
+            break;
+        case COMMAND_REPAIR_ROAD:
+        case COMMAND_SHORTEST_PATH_SINCE:
+            command->valid = args_num == 3 && args[0].clean && args[1].clean;
+            if (command->valid) {
+                command->cities[0] = args[0].text;
+                command->cities[1] = args[1].text;
+                command->year = parseStringToInt(args[2].text);
+            }
+            break;
+        case COMMAND_GET_ROUTE_DESCRIPTION:
+        case COMMAND_REMOVE_ROUTE:
+        case COMMAND_OLDEST_ROADS:
+        case COMMAND_ROUTE_OLDEST_ROAD:
+            command->valid = args_num == 1;
+            if (command->valid)
+                command->route_id = parseStringToUnsigned(args[0].text);
+            break;
+        case COMMAND_NEW_ROUTE:
+            command->valid = args_num == 3 && args[1].clean && args[2].clean;
+            if (command->valid) {
+                command->route_id = parseStringToUnsigned(args[0].text);
+                command->cities[0] = args[1].text;
+                command->cities[1] = args[2].text;
+            }
+            break;
+        case COMMAND_EXTEND_ROUTE:
+            command->valid = args_num == 2 && args[1].clean;
+            if (command->valid) {
+                command->route_id = parseStringToUnsigned(args[0].text);
+                command->cities[0] = args[1].text;
+            }
+            break;
+        case COMMAND_REMOVE_ROAD:
+        case COMMAND_ANALYZE_REMOVE_ROAD:
+        case COMMAND_SHORTEST_PATH:
+        case COMMAND_PARETO_PATHS:
+            command->valid = args_num == 2 && args[0].clean && args[1].clean;
+            if (command->valid) {
+                command->cities[0] = args[0].text;
+                command->cities[1] = args[1].text;
+            }
+            break;
+        case COMMAND_ROADS_OLDER_THAN:
+            command->valid = args_num == 1;
+            if (command->valid)
+                command->year = parseStringToInt(args[0].text);
+            break;
+        case COMMAND_DISTANCE_MATRIX:
+            parseDistanceMatrix(command);
+            break;
+        case COMMAND_REACHABLE:
+            // Limit 0 is correct, so text, which isn't number, is rejected
+            // here instead of being parsed as 0.
+            command->valid = args_num == 2 && args[0].clean &&
+                             isdigit((unsigned char) args[1].text[0]);
+            if (command->valid) {
+                command->cities[0] = args[0].text;
+                command->length = parseStringToUnsigned(args[1].text);
+            }
+            break;
+        case COMMAND_K_SHORTEST_PATHS:
+            command->valid = args_num == 3 && args[0].clean && args[1].clean;
+            if (command->valid) {
+                command->cities[0] = args[0].text;
+                command->cities[1] = args[1].text;
+                command->route_id = parseStringToUnsigned(args[2].text);
+            }
+            break;
+        case COMMAND_BEGIN_BULK_LOAD:
+        case COMMAND_FLUSH:
+        case COMMAND_STATS:
+            command->valid = args_num == 0;
+            break;
+        default:
+            command->valid = false;
+            break;
+    }
+}
+
+/** @brief Initiates empty command.
+ * @param command [out]    - pointer to command.
+ */
+void initCommand(command_t *command) {
+    command->type = COMMAND_EMPTY;
+    command->line_number = 0;
+    command->valid = true;
+    command->text = NULL;
+    command->text_len = 0;
+    command->text_capacity = 0;
+    initLineScan(&command->scan);
+    command->fields = NULL;
+    command->fields_num = 0;
+    command->fields_capacity = 0;
+    command->cities[0] = command->cities[1] = NULL;
+    command->roads = NULL;
+    command->roads_num = 0;
+    command->roads_capacity = 0;
+    command->names = NULL;
+    command->names_num = 0;
+    command->names_capacity = 0;
+    command->sources_num = 0;
+}
+
+/** @brief Frees buffers of command.
+ * @param command [in,out] - pointer to command.
+ */
+void clearCommand(command_t *command) {
+    MEMORY_FREE(MEMORY_PARSER, command->text);
+    MEMORY_FREE(MEMORY_PARSER, command->fields);
+    MEMORY_FREE(MEMORY_PARSER, command->roads);
+    MEMORY_FREE(MEMORY_PARSER, command->names);
+    clearLineScan(&command->scan);
+    initCommand(command);
+}
+
+/** @brief Appends text to line stored in command.
+ * Text is always terminated by '\0' and followed by @ref SCAN_PADDING
+ * bytes, so it can be scanned by @ref scanLine.
+ * @param command [in,out] - pointer to command,
+ * @param text [in]        - pointer to text,
+ * @param len [in]         - length of text.
+ * @return Value @p true if text was appended. Value @p false if allocation
+ * error occurred.
+ */
+bool appendCommandText(command_t *command, const char *text, size_t len) {
+    if (command->text_len + len + 1 + SCAN_PADDING > command->text_capacity) {
+        size_t new_capacity = command->text_capacity == 0
+                              ? 256 : command->text_capacity;
+        char *new_text;
+
+        while (new_capacity < command->text_len + len + 1 + SCAN_PADDING)
+            new_capacity *= 2;
+        new_text = (char *) MEMORY_REALLOC(MEMORY_PARSER, command->text,
+                                           new_capacity);
+        if (new_text == NULL)
+            return false;
+        command->text = new_text;
+        command->text_capacity = new_capacity;
+    }
+
+    memcpy(command->text + command->text_len, text, len);
+    command->text_len += len;
+    command->text[command->text_len] = '\0';
+    return true;
+}
+
+/** @brief Copies original text line of parsed command.
+ * Restores semicolons replaced by parsing. Copy is truncated if buffer is
+ * too small and always terminated by '\0'.
+ * @param command [in]     - pointer to parsed command,
+ * @param buffer [out]     - pointer to buffer,
+ * @param size [in]        - size of buffer.
+ * @return Length of whole text line.
+ */
+size_t copyCommandText(const command_t *command, char *buffer, size_t size) {
+    size_t len = command->type == COMMAND_EMPTY
+                 ? strcspn(command->text, "\n") : command->scan.len;
+    size_t copied = len < size ? len : size - 1;
+
+    for (size_t i = 0; i < copied; i++)
+        buffer[i] = command->text[i] == '\0' ? ';' : command->text[i];
+    buffer[copied] = '\0';
+    return len;
+}
+
+/** @brief Parses text line stored in command.
+ * Sets type of command and its arguments. Doesn't modify map, but tracks
+ * if lines belong to bulk load block. Line is scanned once, command name
+ * is found using perfect hash.
+ * @param command [in,out]     - pointer to command,
+ * @param bulk_active [in,out] - flag indicating if bulk load block is read.
+ */
+void parseCommand(command_t *command, bool *bulk_active) {
+    char *line = command->text;
+
+    command->valid = true;
+    command->cities[0] = command->cities[1] = NULL;
+    command->roads_num = 0;
+    command->names_num = 0;
+    command->fields_num = 0;
+    command->scan.len = 0;
+
+    if (*line == '#' || *line == '\n') {
+        command->type = COMMAND_EMPTY;
+        return;
+    }
+
+    command->type = COMMAND_INVALID;
+    if (!scanLine(&command->scan, line, command->text_len)) {
+        command->type = COMMAND_CRITICAL_ERROR;
+        return;
+    }
+    if (command->scan.len == 0)
+        return;
+
+    if (*bulk_active) {
+        if (command->scan.marks_num == 0 &&
+            findCommandType(line, command->scan.len) == COMMAND_END_BULK_LOAD) {
+            command->type = COMMAND_END_BULK_LOAD;
+            *bulk_active = false;
+        } else {
+            parseBulkRoad(command);
+        }
+        return;
+    }
+
+    if (isSemicolonLast(command))
+        return;
+    if (!splitFields(command)) {
+        command->type = COMMAND_CRITICAL_ERROR;
+        return;
+    }
+    if (command->fields_num == 0)
+        return;
+
+    command->type = findCommandType(command->fields[0].text,
+                                    command->fields[0].len);
+    if (command->type == COMMAND_INVALID ||
+        command->type == COMMAND_END_BULK_LOAD) {
+        command->type = COMMAND_INVALID;
+        command->route_id = parseStringToUnsigned(command->fields[0].text);
+        if (checkRouteId(command->route_id)) {
+            command->type = COMMAND_CREATE_ROUTE;
+            parseCreateRoute(command);
+        }
+        return;
+    }
+
+    parseArguments(command);
+    if (command->type == COMMAND_BEGIN_BULK_LOAD && command->valid)
+        *bulk_active = true;
+}
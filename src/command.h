@@ -0,0 +1,109 @@
+/** @file
+ * Interface of parsed text interface commands.
+ * Parsing validates and tokenizes text line without touching map, so it
+ * can be done by other thread than executing commands.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_COMMAND_H
+#define ROADS_COMMAND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "roads_types.h"
+#include "scanner.h"
+
+/**
+ * Type of parsed command.
+ */
+typedef enum command_type {
+    COMMAND_EMPTY,              /**< Empty line or comment. */
+    COMMAND_INVALID,            /**< Line which isn't correct command. */
+    COMMAND_ADD_ROAD,           /**< Command addRoad. */
+    COMMAND_REPAIR_ROAD,        /**< Command repairRoad. */
+    COMMAND_GET_ROUTE_DESCRIPTION, /**< Command getRouteDescription. */
+    COMMAND_NEW_ROUTE,          /**< Command newRoute. */
+    COMMAND_EXTEND_ROUTE,       /**< Command extendRoute. */
+    COMMAND_REMOVE_ROAD,        /**< Command removeRoad. */
+    COMMAND_ANALYZE_REMOVE_ROAD, /**< Command analyzeRemoveRoad. */
+    COMMAND_REMOVE_ROUTE,       /**< Command removeRoute. */
+    COMMAND_SHORTEST_PATH,      /**< Command shortestPath. */
+    COMMAND_DISTANCE_MATRIX,    /**< Command distanceMatrix. */
+    COMMAND_REACHABLE,          /**< Command reachable. */
+    COMMAND_K_SHORTEST_PATHS,   /**< Command kShortestPaths. */
+    COMMAND_PARETO_PATHS,       /**< Command paretoPaths. */
+    COMMAND_SHORTEST_PATH_SINCE, /**< Command shortestPathSince. */
+    COMMAND_OLDEST_ROADS,       /**< Command oldestRoads. */
+    COMMAND_ROADS_OLDER_THAN,   /**< Command roadsOlderThan. */
+    COMMAND_ROUTE_OLDEST_ROAD,  /**< Command routeOldestRoad. */
+    COMMAND_CREATE_ROUTE,       /**< Route description creating route. */
+    COMMAND_BEGIN_BULK_LOAD,    /**< Command beginBulkLoad. */
+    COMMAND_BULK_ROAD,          /**< Road line inside bulk load block. */
+    COMMAND_END_BULK_LOAD,      /**< Command endBulkLoad. */
+    COMMAND_FLUSH,              /**< Command flush. */
+    COMMAND_STATS,              /**< Command stats. */
+    COMMAND_END_OF_INPUT,       /**< End of input. */
+    COMMAND_CRITICAL_ERROR,     /**< Allocation error during parsing. */
+    COMMAND_TYPES_NUM           /**< Number of types of commands. */
+} command_type_t;
+
+/**
+ * Structure describing field of text line, which is non-empty text between
+ * semicolons.
+ */
+typedef struct field {
+    char *text;                 /**< Field terminated by '\0'. */
+    size_t len;                 /**< Length of field. */
+    bool clean;                 /**< Flag indicating if field doesn't contain
+                                     control characters. */
+} field_t;
+
+/**
+ * Structure representing parsed text line.
+ * Buffers are reused by next parsed lines. City names point to text buffer.
+ */
+typedef struct command {
+    command_type_t type;        /**< Type of command. */
+    int line_number;            /**< Number of line in input. */
+    bool valid;                 /**< Flag indicating if arguments are valid,
+                                     invalid command always fails. */
+
+    char *text;                 /**< Buffer with text line. */
+    size_t text_len;            /**< Length of text line. */
+    size_t text_capacity;       /**< Size of text buffer. */
+    line_scan_t scan;           /**< Result of scanning text line. */
+    field_t *fields;            /**< Fields of text line. */
+    size_t fields_num;          /**< Number of fields. */
+    size_t fields_capacity;     /**< Size of array of fields. */
+
+    const char *cities[2];      /**< City names used by command. */
+    unsigned route_id;          /**< Route number or number of paths or
+                                     roads. */
+    unsigned length;            /**< Road length or limit of path length. */
+    int year;                   /**< Built or repair year. */
+
+    road_desc_t *roads;         /**< Roads of created route. */
+    size_t roads_num;           /**< Number of roads of created route. */
+    size_t roads_capacity;      /**< Size of array of roads. */
+
+    const char **names;         /**< Sources followed by targets of distance
+                                     matrix. */
+    size_t names_num;           /**< Number of sources and targets. */
+    size_t names_capacity;      /**< Size of array of names. */
+    size_t sources_num;         /**< Number of sources. */
+} command_t;
+
+void initCommand(command_t *command);
+
+void clearCommand(command_t *command);
+
+bool appendCommandText(command_t *command, const char *text, size_t len);
+
+void parseCommand(command_t *command, bool *bulk_active);
+
+size_t copyCommandText(const command_t *command, char *buffer, size_t size);
+
+#endif //ROADS_COMMAND_H
@@ -0,0 +1,162 @@
+/** @file
+ * Implementation of lock-free single-producer single-consumer queue
+ * of commands.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "command_queue.h"
+#include "memory_stats.h"
+
+/**
+ * Macro defining how many times waiting thread checks queue before yielding.
+ */
+#define SPIN_LIMIT 128
+/**
+ * Macro defining how many times waiting thread yields before sleeping.
+ */
+#define YIELD_LIMIT 64
+/**
+ * Macro defining maximal sleep of waiting thread in nanoseconds.
+ */
+#define MAX_SLEEP_NS 1000000
+
+/** @brief Waits a bit before next check of queue.
+ * Busy waits first, then yields processor and finally sleeps increasingly
+ * longer, so idle interactive session doesn't consume processor.
+ * @param round [in,out]   - number of previous unsuccessful checks.
+ */
+static void backoff(unsigned *round) {
+    (*round)++;
+    if (*round < SPIN_LIMIT)
+        return;
+    if (*round < SPIN_LIMIT + YIELD_LIMIT) {
+        sched_yield();
+    } else {
+        unsigned shift = *round - SPIN_LIMIT - YIELD_LIMIT;
+        long sleep_ns = shift >= 10 ? MAX_SLEEP_NS : (1000L << shift);
+        struct timespec time = {0, sleep_ns > MAX_SLEEP_NS ? MAX_SLEEP_NS
+                                                           : sleep_ns};
+        nanosleep(&time, NULL);
+    }
+}
+
+/** @brief Creates empty queue.
+ * @param capacity [in]    - number of slots, must be power of 2.
+ * @return Pointer to new queue or NULL if allocation error occurred.
+ */
+command_queue_t *createCommandQueue(size_t capacity) {
+    command_queue_t *queue = (command_queue_t *) MEMORY_ALLOC(
+            MEMORY_PARSER, sizeof(command_queue_t));
+
+    if (queue == NULL)
+        return NULL;
+
+    queue->slots = (command_t *) MEMORY_ALLOC(MEMORY_PARSER,
+                                              sizeof(command_t) *
+                                              capacity);
+    if (queue->slots == NULL) {
+        MEMORY_FREE(MEMORY_PARSER, queue);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < capacity; i++)
+        initCommand(&queue->slots[i]);
+    queue->capacity = capacity;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->published = 0;
+    queue->reserved = 0;
+    atomic_init(&queue->closed, false);
+    return queue;
+}
+
+/** @brief Deletes queue and buffers of all commands.
+ * Assumes that neither producer nor consumer uses queue.
+ * @param queue [in]       - pointer to queue.
+ */
+void deleteCommandQueue(command_queue_t *queue) {
+    if (queue == NULL)
+        return;
+    for (size_t i = 0; i < queue->capacity; i++)
+        clearCommand(&queue->slots[i]);
+    MEMORY_FREE(MEMORY_PARSER, queue->slots);
+    MEMORY_FREE(MEMORY_PARSER, queue);
+}
+
+/** @brief Reserves slot for next command.
+ * Used only by producer. Command is visible to consumer after next call
+ * of @ref publishCommands. Waits until there is free slot, reserved
+ * commands are published before waiting, because consumer may wait for them.
+ * @param queue [in,out]   - pointer to queue.
+ * @return Pointer to command in reserved slot or NULL if consumer closed
+ * queue.
+ */
+command_t *reserveCommand(command_queue_t *queue) {
+    unsigned round = 0;
+
+    while (queue->reserved -
+           atomic_load_explicit(&queue->head, memory_order_acquire) ==
+           queue->capacity) {
+        publishCommands(queue);
+        if (atomic_load_explicit(&queue->closed, memory_order_relaxed))
+            return NULL;
+        backoff(&round);
+    }
+    if (atomic_load_explicit(&queue->closed, memory_order_relaxed))
+        return NULL;
+    return &queue->slots[queue->reserved++ & (queue->capacity - 1)];
+}
+
+/** @brief Makes all reserved commands visible to consumer.
+ * Used only by producer.
+ * @param queue [in,out]   - pointer to queue.
+ */
+void publishCommands(command_queue_t *queue) {
+    if (atomic_load_explicit(&queue->tail, memory_order_relaxed) !=
+        queue->reserved)
+        atomic_store_explicit(&queue->tail, queue->reserved,
+                              memory_order_release);
+}
+
+/** @brief Takes first published command.
+ * Used only by consumer. Waits until any command is published. Position
+ * of last published command is read again only after all commands known
+ * to be published are taken.
+ * @param queue [in,out]   - pointer to queue.
+ * @return Pointer to command.
+ */
+command_t *takeCommand(command_queue_t *queue) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    unsigned round = 0;
+
+    while (queue->published == head) {
+        queue->published = atomic_load_explicit(&queue->tail,
+                                                 memory_order_acquire);
+        if (queue->published == head)
+            backoff(&round);
+    }
+    return &queue->slots[head & (queue->capacity - 1)];
+}
+
+/** @brief Returns slot of taken command to producer.
+ * Used only by consumer.
+ * @param queue [in,out]   - pointer to queue.
+ */
+void releaseCommand(command_queue_t *queue) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+}
+
+/** @brief Marks that consumer won't take any more commands.
+ * Producer waiting for free slot stops waiting.
+ * @param queue [in,out]   - pointer to queue.
+ */
+void closeCommandQueue(command_queue_t *queue) {
+    atomic_store_explicit(&queue->closed, true, memory_order_relaxed);
+}
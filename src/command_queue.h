@@ -0,0 +1,52 @@
+/** @file
+ * Interface of lock-free single-producer single-consumer queue of commands.
+ * Queue is ring buffer of commands, which buffers are reused. Producer
+ * reserves and fills slots, then publishes all of them at once, consumer
+ * takes published slots one by one and releases them after execution.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_COMMAND_QUEUE_H
+#define ROADS_COMMAND_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "command.h"
+
+/**
+ * Structure representing queue of commands.
+ * Positions grow infinitely, slot number is position modulo capacity.
+ */
+typedef struct command_queue {
+    command_t *slots;           /**< Array of commands. */
+    size_t capacity;            /**< Number of slots, power of 2. */
+    atomic_size_t head;         /**< Position of first published slot,
+                                     written only by consumer. */
+    size_t published;           /**< Position after last slot known to be
+                                     published, used only by consumer. */
+    atomic_size_t tail;         /**< Position after last published slot,
+                                     written only by producer. */
+    size_t reserved;            /**< Position after last reserved slot,
+                                     used only by producer. */
+    atomic_bool closed;         /**< Flag indicating that consumer stopped. */
+} command_queue_t;
+
+command_queue_t *createCommandQueue(size_t capacity);
+
+void deleteCommandQueue(command_queue_t *queue);
+
+command_t *reserveCommand(command_queue_t *queue);
+
+void publishCommands(command_queue_t *queue);
+
+command_t *takeCommand(command_queue_t *queue);
+
+void releaseCommand(command_queue_t *queue);
+
+void closeCommandQueue(command_queue_t *queue);
+
+#endif //ROADS_COMMAND_QUEUE_H
@@ -0,0 +1,178 @@
+/** @file
+ * Implementation of statistics of executed commands.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "command_stats.h"
+
+/**
+ * Macro defining maximal length of line of report.
+ */
+#define REPORT_LINE_LENGTH 512
+
+/**
+ * Names of reported types of commands. Other types aren't reported.
+ */
+static const char *const reported_names[COMMAND_TYPES_NUM] = {
+        [COMMAND_ADD_ROAD] = "addRoad",
+        [COMMAND_REPAIR_ROAD] = "repairRoad",
+        [COMMAND_GET_ROUTE_DESCRIPTION] = "getRouteDescription",
+        [COMMAND_NEW_ROUTE] = "newRoute",
+        [COMMAND_EXTEND_ROUTE] = "extendRoute",
+        [COMMAND_REMOVE_ROAD] = "removeRoad",
+        [COMMAND_ANALYZE_REMOVE_ROAD] = "analyzeRemoveRoad",
+        [COMMAND_REMOVE_ROUTE] = "removeRoute",
+        [COMMAND_SHORTEST_PATH] = "shortestPath",
+        [COMMAND_DISTANCE_MATRIX] = "distanceMatrix",
+        [COMMAND_REACHABLE] = "reachable",
+        [COMMAND_K_SHORTEST_PATHS] = "kShortestPaths",
+        [COMMAND_PARETO_PATHS] = "paretoPaths",
+        [COMMAND_SHORTEST_PATH_SINCE] = "shortestPathSince",
+        [COMMAND_OLDEST_ROADS] = "oldestRoads",
+        [COMMAND_ROADS_OLDER_THAN] = "roadsOlderThan",
+        [COMMAND_ROUTE_OLDEST_ROAD] = "routeOldestRoad",
+        [COMMAND_CREATE_ROUTE] = "createRoute",
+        [COMMAND_END_BULK_LOAD] = "bulkLoad",
+        [COMMAND_INVALID] = "invalid",
+};
+
+/** @brief Creates empty statistics.
+ * @return Pointer to statistics or NULL if allocation error occurred.
+ */
+command_stats_t *createCommandStats() {
+    command_stats_t *stats = (command_stats_t *) malloc(
+            sizeof(command_stats_t));
+
+    if (stats == NULL)
+        return NULL;
+
+    for (int i = 0; i < COMMAND_TYPES_NUM; i++) {
+        stats->ok[i] = 0;
+        stats->errors[i] = 0;
+        initHistogram(&stats->latency[i]);
+        resetSearchStats(&stats->search[i]);
+    }
+    return stats;
+}
+
+/** @brief Deletes statistics.
+ * @param stats [in,out]   - pointer to statistics.
+ */
+void deleteCommandStats(command_stats_t *stats) {
+    free(stats);
+}
+
+/** @brief Reads monotonic clock.
+ * @return Time in nanoseconds.
+ */
+uint64_t getTimeNs() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+/** @brief Records executed command.
+ * Path searches done by current thread since previous recorded command are
+ * assigned to this command.
+ * @param stats [in,out]   - pointer to statistics,
+ * @param type [in]        - type of command,
+ * @param ok [in]          - flag indicating if command succeeded,
+ * @param time [in]        - execution time in nanoseconds.
+ */
+void recordCommand(command_stats_t *stats, command_type_t type, bool ok,
+                   uint64_t time) {
+    if (ok)
+        stats->ok[type]++;
+    else
+        stats->errors[type]++;
+    recordHistogram(&stats->latency[type], time);
+#ifdef ROADS_SEARCH_STATS
+    addSearchStats(&stats->search[type], &search_stats);
+    resetSearchStats(&search_stats);
+#endif
+}
+
+/** @brief Reports work of path searches done by commands of given type.
+ * @param name [in]        - name of type of commands,
+ * @param search [in]      - pointer to statistics of path searches,
+ * @param report [in]      - function called for line,
+ * @param data [in,out]    - argument passed to @p report.
+ */
+static void reportSearchStats(const char *name, const search_stats_t *search,
+                              void (*report)(const char *line, void *data),
+                              void *data) {
+    char line[REPORT_LINE_LENGTH];
+
+    snprintf(line, sizeof(line), "%s search=%" PRIu64 " settled=%" PRIu64
+             " relaxed=%" PRIu64 " decreased=%" PRIu64 " pops=%" PRIu64
+             " heap=%" PRIu64 " pushes=%" PRIu64 " routes=%" PRIu64
+             " bridge_scans=%" PRIu64 " bridge_rejects=%" PRIu64
+             " component_builds=%" PRIu64 " component_rejects=%" PRIu64
+             " target=%" PRIu64 " unreachable=%" PRIu64 " ambiguous=%" PRIu64
+             " error=%" PRIu64,
+             name, search->searches, search->settled, search->relaxed,
+             search->decreased, search->pops, search->heap_init,
+             search->pushes, search->routes, search->bridge_scans, search->bridge_rejects,
+             search->component_builds, search->component_rejects,
+             search->ends[SEARCH_END_TARGET],
+             search->ends[SEARCH_END_UNREACHABLE],
+             search->ends[SEARCH_END_AMBIGUOUS],
+             search->ends[SEARCH_END_ERROR]);
+    report(line, data);
+}
+
+/** @brief Reports statistics line by line.
+ * Every reported type of command has line with number of commands,
+ * percentiles and maximum of execution time and total execution time.
+ * If commands of type did path searches, it is followed by line with
+ * their work: numbers of searches, settled cities, relaxed roads, successful
+ * decrease-key operations, heap pops, sum of initial heap sizes, number of
+ * insertions into heap, number of routes which needed diversion and numbers of searches ended for every
+ * reason.
+ * Last line contains totals of all commands. Times are in nanoseconds.
+ * @param stats [in]       - pointer to statistics,
+ * @param report [in]      - function called for every line,
+ * @param data [in,out]    - argument passed to @p report.
+ */
+void reportCommandStats(const command_stats_t *stats,
+                        void (*report)(const char *line, void *data),
+                        void *data) {
+    char line[REPORT_LINE_LENGTH];
+    uint64_t ok = 0, errors = 0, time = 0;
+
+    for (int i = 0; i < COMMAND_TYPES_NUM; i++) {
+        const histogram_t *latency = &stats->latency[i];
+
+        ok += stats->ok[i];
+        errors += stats->errors[i];
+        time += latency->sum;
+        if (reported_names[i] == NULL)
+            continue;
+
+        snprintf(line, sizeof(line), "%s calls=%" PRIu64 " ok=%" PRIu64
+                 " error=%" PRIu64 " p50=%" PRIu64 " p99=%" PRIu64
+                 " p999=%" PRIu64 " max=%" PRIu64 " total=%" PRIu64,
+                 reported_names[i], latency->count, stats->ok[i],
+                 stats->errors[i], histogramPercentile(latency, 50),
+                 histogramPercentile(latency, 99),
+                 histogramPercentile(latency, 99.9), latency->max,
+                 latency->sum);
+        report(line, data);
+        if (stats->search[i].searches > 0)
+            reportSearchStats(reported_names[i], &stats->search[i], report,
+                              data);
+    }
+
+    snprintf(line, sizeof(line), "all calls=%" PRIu64 " ok=%" PRIu64
+             " error=%" PRIu64 " total=%" PRIu64, ok + errors, ok, errors,
+             time);
+    report(line, data);
+}
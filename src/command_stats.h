@@ -0,0 +1,45 @@
+/** @file
+ * Interface of statistics of executed commands.
+ * For every type of command counts successful and failed commands and
+ * records their execution time and work of path searches done by them.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_COMMAND_STATS_H
+#define ROADS_COMMAND_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "command.h"
+#include "histogram.h"
+#include "search_stats.h"
+
+/**
+ * Structure representing statistics of commands.
+ */
+typedef struct command_stats {
+    uint64_t ok[COMMAND_TYPES_NUM];         /**< Number of successful
+                                                 commands. */
+    uint64_t errors[COMMAND_TYPES_NUM];     /**< Number of failed commands. */
+    histogram_t latency[COMMAND_TYPES_NUM]; /**< Execution times in
+                                                 nanoseconds. */
+    search_stats_t search[COMMAND_TYPES_NUM];   /**< Path searches. */
+} command_stats_t;
+
+command_stats_t *createCommandStats();
+
+void deleteCommandStats(command_stats_t *stats);
+
+uint64_t getTimeNs();
+
+void recordCommand(command_stats_t *stats, command_type_t type, bool ok,
+                   uint64_t time);
+
+void reportCommandStats(const command_stats_t *stats,
+                        void (*report)(const char *line, void *data),
+                        void *data);
+
+#endif //ROADS_COMMAND_STATS_H
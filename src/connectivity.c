@@ -0,0 +1,206 @@
+/** @file
+ * Implementation of index of connected components of map of roads.
+ * Index is union-find over city numbers with union by rank and path halving.
+ * Cities added since last change of index are their own components.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <stdlib.h>
+
+#include "connectivity.h"
+#include "list.h"
+#include "memory_stats.h"
+#include "search_stats.h"
+
+/**
+ * Structure representing index of connected components.
+ */
+struct connectivity {
+    unsigned capacity;          /**< Size of arrays. */
+    unsigned size;              /**< Number of cities in index. */
+    unsigned *parents;          /**< Parents of cities in union-find. */
+    unsigned char *ranks;       /**< Ranks of cities in union-find. */
+    bool valid;                 /**< Flag indicating if index describes
+                                     components of map. */
+};
+
+/** @brief Creates empty index.
+ * @return Pointer to index or NULL if allocation error occurred.
+ */
+connectivity_t *createConnectivity(void) {
+    connectivity_t *connectivity =
+            (connectivity_t *) MEMORY_CALLOC(MEMORY_MAP, 1,
+                                             sizeof(connectivity_t));
+
+    if (connectivity == NULL)
+        return NULL;
+    connectivity->valid = true;
+    return connectivity;
+}
+
+/** @brief Deletes index.
+ * Do nothing if pointer is NULL.
+ * @param connectivity [in]    - pointer to index.
+ */
+void deleteConnectivity(connectivity_t *connectivity) {
+    if (connectivity == NULL)
+        return;
+    MEMORY_FREE(MEMORY_MAP, connectivity->parents);
+    MEMORY_FREE(MEMORY_MAP, connectivity->ranks);
+    MEMORY_FREE(MEMORY_MAP, connectivity);
+}
+
+/** @brief Adds new cities to index as separate components.
+ * @param connectivity [in,out]    - pointer to index,
+ * @param cities_num [in]          - number of cities in map.
+ * @return Value @p true if index contains all cities.
+ * Otherwise value @p false.
+ */
+static bool addCitiesToConnectivity(connectivity_t *connectivity,
+                                    unsigned cities_num) {
+    if (cities_num > connectivity->capacity) {
+        unsigned capacity = connectivity->capacity == 0 ? 64
+                                                        : connectivity->capacity;
+        unsigned *parents;
+        unsigned char *ranks;
+
+        while (capacity < cities_num)
+            capacity *= 2;
+        parents = (unsigned *) MEMORY_REALLOC(MEMORY_MAP, connectivity->parents,
+                                              sizeof(unsigned) * capacity);
+        if (parents == NULL)
+            return false;
+        connectivity->parents = parents;
+        ranks = (unsigned char *) MEMORY_REALLOC(MEMORY_MAP,
+                                                 connectivity->ranks,
+                                                 capacity);
+        if (ranks == NULL)
+            return false;
+        connectivity->ranks = ranks;
+        connectivity->capacity = capacity;
+    }
+
+    for (; connectivity->size < cities_num; connectivity->size++) {
+        connectivity->parents[connectivity->size] = connectivity->size;
+        connectivity->ranks[connectivity->size] = 0;
+    }
+    return true;
+}
+
+/** @brief Finds representative of component of city.
+ * @param connectivity [in,out]    - pointer to index,
+ * @param id [in]                  - city number.
+ * @return Number of city representing component.
+ */
+static unsigned findComponent(connectivity_t *connectivity, unsigned id) {
+    unsigned *parents = connectivity->parents;
+
+    while (parents[id] != id) {
+        parents[id] = parents[parents[id]];
+        id = parents[id];
+    }
+    return id;
+}
+
+/** @brief Joins components of two cities.
+ * Assumes that index contains both cities.
+ * @param connectivity [in,out]    - pointer to index,
+ * @param id1 [in]                 - number of first city,
+ * @param id2 [in]                 - number of second city.
+ */
+static void joinComponents(connectivity_t *connectivity, unsigned id1,
+                           unsigned id2) {
+    id1 = findComponent(connectivity, id1);
+    id2 = findComponent(connectivity, id2);
+    if (id1 == id2)
+        return;
+    if (connectivity->ranks[id1] < connectivity->ranks[id2]) {
+        connectivity->parents[id1] = id2;
+    } else {
+        connectivity->parents[id2] = id1;
+        if (connectivity->ranks[id1] == connectivity->ranks[id2])
+            connectivity->ranks[id1]++;
+    }
+}
+
+/** @brief Builds index from all roads of map.
+ * @param map [in,out]     - pointer to map.
+ * @return Value @p true if index was built. Otherwise value @p false.
+ */
+static bool buildConnectivity(Map *map) {
+    connectivity_t *connectivity = map->connectivity;
+    list_t *cities = mapGetValuesList(map->cities);
+    list_t *tmp_node;
+
+    if (cities == NULL)
+        return false;
+
+    connectivity->size = 0;
+    if (!addCitiesToConnectivity(connectivity, map->cities_num)) {
+        deleteList(&cities);
+        return false;
+    }
+
+    tmp_node = cities;
+    while (tmp_node != NULL && tmp_node->value != NULL) {
+        City *city = (City *) tmp_node->value;
+
+        // Every road is joined once, from its first city.
+        for (unsigned i = 0; i < city->roads_num; i++) {
+            if (city->roads[i]->city1 == city)
+                joinComponents(connectivity, city->id,
+                               city->roads[i]->city2->id);
+        }
+        tmp_node = tmp_node->next;
+    }
+    deleteList(&cities);
+    SEARCH_STATS_ADD(component_builds, 1);
+    connectivity->valid = true;
+    return true;
+}
+
+/** @brief Joins components of cities connected by new road.
+ * If index can't be updated, it is marked as invalid.
+ * @param map [in,out]     - pointer to map,
+ * @param city1 [in]       - pointer to first city,
+ * @param city2 [in]       - pointer to second city.
+ */
+void joinCitiesInConnectivity(Map *map, City *city1, City *city2) {
+    connectivity_t *connectivity = map->connectivity;
+
+    if (!connectivity->valid)
+        return;
+    if (!addCitiesToConnectivity(connectivity, map->cities_num)) {
+        connectivity->valid = false;
+        return;
+    }
+    joinComponents(connectivity, city1->id, city2->id);
+}
+
+/** @brief Marks that components of map could be split.
+ * @param map [in,out]     - pointer to map.
+ */
+void invalidateConnectivity(Map *map) {
+    map->connectivity->valid = false;
+}
+
+/** @brief Checks if cities can be connected by any way.
+ * Rebuilds index if it is invalid.
+ * @param map [in,out]     - pointer to map,
+ * @param city1 [in]       - pointer to first city,
+ * @param city2 [in]       - pointer to second city.
+ * @return Value @p false if cities are in different components. Value
+ * @p true if cities are in the same component or allocation error occurred.
+ */
+bool checkIfCitiesMayBeConnected(Map *map, City *city1, City *city2) {
+    connectivity_t *connectivity = map->connectivity;
+
+    if (!connectivity->valid && !buildConnectivity(map))
+        return true;
+    if (!addCitiesToConnectivity(connectivity, map->cities_num))
+        return true;
+    return findComponent(connectivity, city1->id) ==
+           findComponent(connectivity, city2->id);
+}
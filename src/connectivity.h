@@ -0,0 +1,27 @@
+/** @file
+ * Interface of index of connected components of map of roads.
+ * Components are joined by union-find when roads are added. Removing road
+ * can split component, then index is rebuilt lazily when it is needed.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_CONNECTIVITY_H
+#define ROADS_CONNECTIVITY_H
+
+#include <stdbool.h>
+
+#include "roads_types.h"
+
+connectivity_t *createConnectivity(void);
+
+void deleteConnectivity(connectivity_t *connectivity);
+
+void joinCitiesInConnectivity(Map *map, City *city1, City *city2);
+
+void invalidateConnectivity(Map *map);
+
+bool checkIfCitiesMayBeConnected(Map *map, City *city1, City *city2);
+
+#endif //ROADS_CONNECTIVITY_H
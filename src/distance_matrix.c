@@ -0,0 +1,118 @@
+/** @file
+ * Implementation of module computing distances between many pairs of cities.
+ * Every source is searched once by Dijkstra algorithm, which stops when all
+ * targets from component of source are settled. Sources are searched in
+ * parallel.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <stdlib.h>
+
+#include "distance_matrix.h"
+#include "connectivity.h"
+#include "memory_stats.h"
+#include "parallel_search.h"
+#include "search.h"
+
+/**
+ * Structure describing matrix computed by threads.
+ */
+typedef struct matrix_task {
+    Map *map;                   /**< Pointer to map. */
+    City **sources;             /**< Array of sources. */
+    size_t sources_num;         /**< Number of sources. */
+    City **targets;             /**< Array of targets. */
+    size_t targets_num;         /**< Number of targets. */
+    unsigned char *targets_mask; /**< Array indexed by city number, nonzero
+                                      for targets. */
+    size_t *targets_left;       /**< Numbers of different targets reachable
+                                     from every source. */
+    distance_t *distances;      /**< Matrix of distances, row for every
+                                     source. */
+} matrix_task_t;
+
+/** @brief Computes row of matrix.
+ * @param workspace [in,out] - pointer to workspace of thread,
+ * @param map [in,out]       - pointer to map,
+ * @param data [in,out]      - pointer to computed matrix,
+ * @param source [in]        - number of source.
+ * @return Value @p true if row was computed. Value @p false if allocation
+ * error occurred.
+ */
+static bool computeRow(search_workspace_t *workspace, Map *map, void *data,
+                       size_t source) {
+    matrix_task_t *task = (matrix_task_t *) data;
+
+    return searchDistances(workspace, map, task->sources[source],
+                           task->targets_mask, task->targets_left[source],
+                           task->targets, task->targets_num,
+                           task->distances + source * task->targets_num);
+}
+
+/** @brief Counts targets reachable from every source.
+ * Marks targets in mask. Uses index of connected components, so search
+ * from source can stop when its last reachable target is settled.
+ * @param task [in,out]    - pointer to computed matrix.
+ */
+static void countReachableTargets(matrix_task_t *task) {
+    for (size_t i = 0; i < task->sources_num; i++)
+        task->targets_left[i] = 0;
+
+    for (size_t j = 0; j < task->targets_num; j++) {
+        City *target = task->targets[j];
+
+        if (task->targets_mask[target->id])
+            continue;
+        task->targets_mask[target->id] = 1;
+        for (size_t i = 0; i < task->sources_num; i++) {
+            if (checkIfCitiesMayBeConnected(task->map, task->sources[i],
+                                            target))
+                task->targets_left[i]++;
+        }
+    }
+}
+
+/** @brief Computes distances between every source and every target.
+ * Rows of matrix are computed concurrently.
+ * @param map [in,out]       - pointer to map,
+ * @param sources [in]       - array of sources,
+ * @param sources_num [in]   - number of sources,
+ * @param targets [in]       - array of targets,
+ * @param targets_num [in]   - number of targets,
+ * @param distances [out]    - matrix of @p sources_num rows and
+ *                             @p targets_num columns.
+ * @return Value @p true if distances were computed. Value @p false if
+ * allocation error occurred.
+ */
+bool computeDistanceMatrix(Map *map, City **sources, size_t sources_num,
+                           City **targets, size_t targets_num,
+                           distance_t *distances) {
+    matrix_task_t task;
+    bool result;
+
+    task.map = map;
+    task.sources = sources;
+    task.sources_num = sources_num;
+    task.targets = targets;
+    task.targets_num = targets_num;
+    task.distances = distances;
+
+    task.targets_mask = (unsigned char *) MEMORY_CALLOC(MEMORY_MAP,
+                                                        map->cities_num, 1);
+    task.targets_left = (size_t *) MEMORY_ALLOC(MEMORY_MAP, sizeof(size_t) *
+                                                            sources_num);
+    if (task.targets_mask == NULL || task.targets_left == NULL) {
+        MEMORY_FREE(MEMORY_MAP, task.targets_mask);
+        MEMORY_FREE(MEMORY_MAP, task.targets_left);
+        return false;
+    }
+    countReachableTargets(&task);
+
+    result = runParallelSearches(map, sources_num, computeRow, &task);
+
+    MEMORY_FREE(MEMORY_MAP, task.targets_mask);
+    MEMORY_FREE(MEMORY_MAP, task.targets_left);
+    return result;
+}
@@ -0,0 +1,20 @@
+/** @file
+ * Interface of module computing distances between many pairs of cities.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_DISTANCE_MATRIX_H
+#define ROADS_DISTANCE_MATRIX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "roads_types.h"
+
+bool computeDistanceMatrix(Map *map, City **sources, size_t sources_num,
+                           City **targets, size_t targets_num,
+                           distance_t *distances);
+
+#endif //ROADS_DISTANCE_MATRIX_H
@@ -0,0 +1,63 @@
+/** @file
+ * Implementation of module finding diversions of routes around removed road.
+ * Diversion of every route is searched like in @ref removeRoad, but road
+ * isn't removed and diversions aren't marked as part of routes. Diversions
+ * of different routes don't depend on each other, so they are searched in
+ * parallel.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <limits.h>
+
+#include "diversions.h"
+#include "parallel_search.h"
+#include "path.h"
+#include "search.h"
+
+/** @brief Finds diversion of one route.
+ * Cities of route are excluded and road can't be used. Diversion is kept
+ * only if it's defined unambiguously.
+ * @param workspace [in,out] - pointer to workspace of thread,
+ * @param map [in,out]       - pointer to map,
+ * @param data [in,out]      - array of diversions,
+ * @param item [in]          - number of diversion.
+ * @return Value @p true if diversion was searched. Value @p false if
+ * allocation error occurred.
+ */
+static bool findDiversion(search_workspace_t *workspace, Map *map, void *data,
+                          size_t item) {
+    diversion_t *diversion = (diversion_t *) data + item;
+
+    diversion->path = searchBestPath(workspace, map, diversion->city1,
+                                     diversion->city2,
+                                     &diversion->route->roads, false, INT_MIN,
+                                     &diversion->status);
+    if (diversion->path == NULL)
+        return diversion->status != PATH_ERROR;
+
+    if (!searchIfPathDefinedUnambiguously(workspace, map, diversion->path,
+                                          diversion->city1, diversion->city2,
+                                          &diversion->route->roads, false,
+                                          INT_MIN)) {
+        deletePath(diversion->path);
+        diversion->path = NULL;
+        diversion->status = PATH_AMBIGUOUS;
+    }
+    return true;
+}
+
+/** @brief Finds diversions of routes around road.
+ * Diversions are searched concurrently. Route and cities of every diversion
+ * have to be set.
+ * @param map [in,out]          - pointer to map,
+ * @param diversions [in,out]   - array of diversions,
+ * @param diversions_num [in]   - number of diversions.
+ * @return Value @p true if diversions were searched, then every diversion
+ * has path or status describing why it wasn't found. Value @p false if
+ * allocation error occurred.
+ */
+bool findDiversions(Map *map, diversion_t *diversions, size_t diversions_num) {
+    return runParallelSearches(map, diversions_num, findDiversion, diversions);
+}
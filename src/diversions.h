@@ -0,0 +1,18 @@
+/** @file
+ * Interface of module finding diversions of routes around removed road.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_DIVERSIONS_H
+#define ROADS_DIVERSIONS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "roads_types.h"
+
+bool findDiversions(Map *map, diversion_t *diversions, size_t diversions_num);
+
+#endif //ROADS_DIVERSIONS_H
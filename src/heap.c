@@ -12,6 +12,7 @@
 #include <stdlib.h>
 
 #include "heap.h"
+#include "memory_stats.h"
 #include "utils.h"
 
 /** @brief Swap value in two heap nodes.
@@ -65,15 +66,15 @@ checkIfFirstNodeBetter(heap_t *heap, unsigned node1, unsigned node2) {
  */
 heap_t *createHeap(size_t size) {
     int heap_size = powerOf2Greater(size);
-    heap_t *new_heap = (heap_t *) malloc(sizeof(heap_t));
+    heap_t *new_heap = (heap_t *) MEMORY_ALLOC(MEMORY_HEAP, sizeof(heap_t));
 
     if (new_heap == NULL)
         return NULL;
 
-    new_heap->heap_tab = (heap_node_t *) malloc(
-            sizeof(heap_node_t) * (heap_size + 1));
+    new_heap->heap_tab = (heap_node_t *) MEMORY_ALLOC(
+            MEMORY_HEAP, sizeof(heap_node_t) * (heap_size + 1));
     if (new_heap->heap_tab == NULL) {
-        free(new_heap);
+        MEMORY_FREE(MEMORY_HEAP, new_heap);
         return NULL;
     }
 
@@ -87,8 +88,8 @@ heap_t *createHeap(size_t size) {
 void deleteHeap(heap_t *heap) {
     if (heap == NULL)
         return;
-    free(heap->heap_tab);
-    free(heap);
+    MEMORY_FREE(MEMORY_HEAP, heap->heap_tab);
+    MEMORY_FREE(MEMORY_HEAP, heap);
 }
 
 /** @brief Removes heap node from top.
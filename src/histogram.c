@@ -0,0 +1,106 @@
+/** @file
+ * Implementation of latency histogram.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <string.h>
+
+#include "histogram.h"
+
+/** @brief Finds bucket of value.
+ * Values smaller than 2 * @ref HISTOGRAM_SUB_BUCKETS have own buckets.
+ * Bigger values are shifted, so that they have @ref HISTOGRAM_SUB_BITS + 1
+ * significant bits.
+ * @param value [in]       - value.
+ * @return Index of bucket.
+ */
+static unsigned bucketIndex(uint64_t value) {
+    unsigned shift = 0;
+
+    if (value >= 2 * HISTOGRAM_SUB_BUCKETS)
+        shift = 63 - (unsigned) __builtin_clzll(value) - HISTOGRAM_SUB_BITS;
+    return shift * HISTOGRAM_SUB_BUCKETS + (unsigned) (value >> shift);
+}
+
+/** @brief Finds biggest value stored in bucket.
+ * @param index [in]       - index of bucket.
+ * @return Biggest value of bucket.
+ */
+static uint64_t bucketMaxValue(unsigned index) {
+    unsigned shift = 0;
+    uint64_t significant = index;
+
+    if (index >= 2 * HISTOGRAM_SUB_BUCKETS) {
+        shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+        significant = index % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+    }
+    return ((significant + 1) << shift) - 1;
+}
+
+/** @brief Initiates empty histogram.
+ * @param histogram [out]  - pointer to histogram.
+ */
+void initHistogram(histogram_t *histogram) {
+    memset(histogram, 0, sizeof(histogram_t));
+    histogram->min = UINT64_MAX;
+}
+
+/** @brief Records value.
+ * @param histogram [in,out] - pointer to histogram,
+ * @param value [in]         - recorded value.
+ */
+void recordHistogram(histogram_t *histogram, uint64_t value) {
+    histogram->buckets[bucketIndex(value)]++;
+    histogram->count++;
+    histogram->sum += value;
+    if (value < histogram->min)
+        histogram->min = value;
+    if (value > histogram->max)
+        histogram->max = value;
+}
+
+/** @brief Adds all values of other histogram.
+ * @param histogram [in,out] - pointer to histogram,
+ * @param other [in]         - pointer to added histogram.
+ */
+void mergeHistogram(histogram_t *histogram, const histogram_t *other) {
+    for (unsigned i = 0; i < HISTOGRAM_BUCKETS; i++)
+        histogram->buckets[i] += other->buckets[i];
+    histogram->count += other->count;
+    histogram->sum += other->sum;
+    if (other->min < histogram->min)
+        histogram->min = other->min;
+    if (other->max > histogram->max)
+        histogram->max = other->max;
+}
+
+/** @brief Finds value of given percentile.
+ * Result is the biggest value of bucket containing percentile, but not
+ * bigger than maximal recorded value.
+ * @param histogram [in]   - pointer to histogram,
+ * @param percentile [in]  - percentile from 0 to 100.
+ * @return Value of percentile or @p 0 if histogram is empty.
+ */
+uint64_t histogramPercentile(const histogram_t *histogram, double percentile) {
+    uint64_t rank, seen = 0;
+
+    if (histogram->count == 0)
+        return 0;
+
+    rank = (uint64_t) (percentile / 100.0 * (double) histogram->count + 0.5);
+    if (rank < 1)
+        rank = 1;
+    if (rank > histogram->count)
+        rank = histogram->count;
+
+    for (unsigned i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint64_t value = bucketMaxValue(i);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+    return histogram->max;
+}
@@ -0,0 +1,49 @@
+/** @file
+ * Interface of latency histogram.
+ * Histogram has logarithmic buckets divided into linear sub-buckets, like
+ * HDR histogram, so every recorded value is stored with relative error
+ * smaller than 1/16.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_HISTOGRAM_H
+#define ROADS_HISTOGRAM_H
+
+#include <stdint.h>
+
+/**
+ * Macro defining number of bits of value stored exactly in every bucket.
+ */
+#define HISTOGRAM_SUB_BITS 4
+/**
+ * Macro defining number of sub-buckets of every logarithmic bucket.
+ */
+#define HISTOGRAM_SUB_BUCKETS (1u << HISTOGRAM_SUB_BITS)
+/**
+ * Macro defining number of buckets covering all 64-bit values.
+ */
+#define HISTOGRAM_BUCKETS ((65 - HISTOGRAM_SUB_BITS) * HISTOGRAM_SUB_BUCKETS)
+
+/**
+ * Structure representing histogram.
+ */
+typedef struct histogram {
+    uint64_t count;                         /**< Number of values. */
+    uint64_t sum;                           /**< Sum of values. */
+    uint64_t min;                           /**< Minimal value. */
+    uint64_t max;                           /**< Maximal value. */
+    uint64_t buckets[HISTOGRAM_BUCKETS];    /**< Number of values in every
+                                                 bucket. */
+} histogram_t;
+
+void initHistogram(histogram_t *histogram);
+
+void recordHistogram(histogram_t *histogram, uint64_t value);
+
+void mergeHistogram(histogram_t *histogram, const histogram_t *other);
+
+uint64_t histogramPercentile(const histogram_t *histogram, double percentile);
+
+#endif //ROADS_HISTOGRAM_H
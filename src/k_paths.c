@@ -0,0 +1,372 @@
+/** @file
+ * Implementation of module finding k shortest loopless paths between two
+ * cities. Paths are compared like in @ref findBestPath, first by length,
+ * then by year of oldest road. Uses Yen's algorithm: every next path
+ * deviates from one of found paths in its spur city, so candidates are
+ * best continuations from every city of last found path, which avoid
+ * earlier part of that path and roads used by found paths with the same
+ * beginning. Spur cities before city in which last path deviated from its
+ * parent give only candidates found before, so they are skipped.
+ * Distances to target found once are lower bounds directing every spur
+ * search, and spur searches share one workspace.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "k_paths.h"
+#include "city.h"
+#include "list.h"
+#include "memory_stats.h"
+#include "path.h"
+#include "road.h"
+#include "search.h"
+
+/**
+ * Structure representing set of paths.
+ */
+typedef struct path_set {
+    path_t **paths;             /**< Array of paths. */
+    size_t *deviations;         /**< Numbers of spur cities in which paths
+                                     deviate from their parents. */
+    size_t num;                 /**< Number of paths. */
+    size_t capacity;            /**< Size of arrays. */
+} path_set_t;
+
+/**
+ * Structure representing last found path split into cities and roads.
+ */
+typedef struct path_arrays {
+    City **cities;              /**< Cities of path. */
+    Road **roads;               /**< Roads of path. */
+    size_t roads_num;           /**< Number of roads. */
+    size_t capacity;            /**< Size of array of roads. */
+} path_arrays_t;
+
+/**
+ * Structure representing state of found paths during scan of last path.
+ */
+typedef struct prefix_state {
+    list_t **cursors;           /**< Next roads of found paths. */
+    bool *shared;               /**< Flags indicating if found paths begin
+                                     like scanned part of last path. */
+    Road **spur_roads;          /**< Roads excluded from spur city. */
+    size_t capacity;            /**< Size of arrays. */
+} prefix_state_t;
+
+/** @brief Reallocates array.
+ * Array isn't changed if allocation error occurred.
+ * @param array [in,out]   - pointer to array,
+ * @param size [in]        - new size in bytes.
+ * @return Value @p true if array was reallocated. Otherwise value @p false.
+ */
+static bool resizeArray(void **array, size_t size) {
+    void *new_array = MEMORY_REALLOC(MEMORY_PATH, *array, size);
+
+    if (new_array == NULL)
+        return false;
+    *array = new_array;
+    return true;
+}
+
+/** @brief Adds path to set.
+ * @param set [in,out]     - pointer to set,
+ * @param path [in]        - pointer to path,
+ * @param deviation [in]   - number of spur city of path.
+ * @return Value @p true if path was added. Value @p false if allocation
+ * error occurred.
+ */
+static bool addPathToSet(path_set_t *set, path_t *path, size_t deviation) {
+    if (set->num == set->capacity) {
+        size_t new_capacity = set->capacity == 0 ? 16 : 2 * set->capacity;
+
+        if (!resizeArray((void **) &set->paths,
+                         sizeof(path_t *) * new_capacity) ||
+            !resizeArray((void **) &set->deviations,
+                         sizeof(size_t) * new_capacity))
+            return false;
+        set->capacity = new_capacity;
+    }
+    set->paths[set->num] = path;
+    set->deviations[set->num] = deviation;
+    set->num++;
+    return true;
+}
+
+/** @brief Checks if paths consist of the same roads.
+ * @param path1 [in]       - pointer to first path,
+ * @param path2 [in]       - pointer to second path.
+ * @return Value @p true if paths are equal. Otherwise value @p false.
+ */
+static bool checkIfPathsEqual(path_t *path1, path_t *path2) {
+    list_t *node1 = path1->roads, *node2 = path2->roads;
+
+    if (path1->total_len != path2->total_len || path1->year != path2->year)
+        return false;
+    while (node1->value != NULL && node1->value == node2->value) {
+        node1 = node1->next;
+        node2 = node2->next;
+    }
+    return node1->value == NULL && node2->value == NULL;
+}
+
+/** @brief Checks if set contains path with the same roads.
+ * @param set [in]         - pointer to set,
+ * @param path [in]        - pointer to path.
+ * @return Value @p true if set contains path. Otherwise value @p false.
+ */
+static bool checkIfSetContainsPath(path_set_t *set, path_t *path) {
+    for (size_t i = 0; i < set->num; i++) {
+        if (checkIfPathsEqual(set->paths[i], path))
+            return true;
+    }
+    return false;
+}
+
+/** @brief Removes best path from set.
+ * From paths with equal length and year, the earliest added is chosen.
+ * @param set [in,out]     - pointer to non-empty set,
+ * @param deviation [out]  - number of spur city of path.
+ * @return Pointer to removed path.
+ */
+static path_t *removeBestPathFromSet(path_set_t *set, size_t *deviation) {
+    size_t best = 0;
+    path_t *path;
+
+    for (size_t i = 1; i < set->num; i++) {
+        path_t *curr = set->paths[i];
+
+        if (curr->total_len < set->paths[best]->total_len ||
+            (curr->total_len == set->paths[best]->total_len &&
+             curr->year > set->paths[best]->year))
+            best = i;
+    }
+
+    path = set->paths[best];
+    *deviation = set->deviations[best];
+    for (size_t i = best + 1; i < set->num; i++) {
+        set->paths[i - 1] = set->paths[i];
+        set->deviations[i - 1] = set->deviations[i];
+    }
+    set->num--;
+    return path;
+}
+
+/** @brief Splits path into arrays of cities and roads.
+ * @param arrays [in,out]  - pointer to arrays,
+ * @param path [in]        - pointer to path,
+ * @param city1 [in]       - pointer to first city of path.
+ * @return Value @p true if path was split. Value @p false if allocation
+ * error occurred.
+ */
+static bool splitPath(path_arrays_t *arrays, path_t *path, City *city1) {
+    list_t *tmp_node = path->roads;
+    City *curr_city = city1;
+
+    arrays->roads_num = 0;
+    while (tmp_node->value != NULL) {
+        if (arrays->roads_num == arrays->capacity) {
+            size_t new_capacity = arrays->capacity == 0
+                                  ? 64 : 2 * arrays->capacity;
+
+            if (!resizeArray((void **) &arrays->cities,
+                             sizeof(City *) * (new_capacity + 1)) ||
+                !resizeArray((void **) &arrays->roads,
+                             sizeof(Road *) * new_capacity))
+                return false;
+            arrays->capacity = new_capacity;
+        }
+        arrays->cities[arrays->roads_num] = curr_city;
+        arrays->roads[arrays->roads_num++] = (Road *) tmp_node->value;
+        curr_city = getNextCity(curr_city, (Road *) tmp_node->value);
+        tmp_node = tmp_node->next;
+    }
+    return true;
+}
+
+/** @brief Prepares state of found paths before scan of last path.
+ * @param state [in,out]   - pointer to state,
+ * @param found [in]       - pointer to set of found paths.
+ * @return Value @p true if state was prepared. Value @p false if allocation
+ * error occurred.
+ */
+static bool resetPrefixState(prefix_state_t *state, path_set_t *found) {
+    if (found->num > state->capacity) {
+        size_t new_capacity = found->capacity;
+
+        if (!resizeArray((void **) &state->cursors,
+                         sizeof(list_t *) * new_capacity) ||
+            !resizeArray((void **) &state->shared,
+                         sizeof(bool) * new_capacity) ||
+            !resizeArray((void **) &state->spur_roads,
+                         sizeof(Road *) * new_capacity))
+            return false;
+        state->capacity = new_capacity;
+    }
+    for (size_t i = 0; i < found->num; i++) {
+        state->cursors[i] = found->paths[i]->roads;
+        state->shared[i] = true;
+    }
+    return true;
+}
+
+/** @brief Collects roads excluded from spur city.
+ * These are next roads of found paths, which begin like scanned part of
+ * last path.
+ * @param state [in,out]   - pointer to state,
+ * @param found_num [in]   - number of found paths.
+ * @return Number of excluded roads.
+ */
+static size_t collectSpurRoads(prefix_state_t *state, size_t found_num) {
+    size_t spur_roads_num = 0;
+
+    for (size_t i = 0; i < found_num; i++) {
+        if (state->shared[i] && state->cursors[i]->value != NULL)
+            state->spur_roads[spur_roads_num++] =
+                    (Road *) state->cursors[i]->value;
+    }
+    return spur_roads_num;
+}
+
+/** @brief Moves state of found paths to next road of last path.
+ * @param state [in,out]   - pointer to state,
+ * @param found_num [in]   - number of found paths,
+ * @param road [in]        - pointer to road of last path.
+ */
+static void advancePrefixState(prefix_state_t *state, size_t found_num,
+                               Road *road) {
+    for (size_t i = 0; i < found_num; i++) {
+        if (!state->shared[i])
+            continue;
+        state->shared[i] = state->cursors[i]->value == road;
+        state->cursors[i] = state->cursors[i]->next;
+    }
+}
+
+/** @brief Adds candidates deviating from last found path.
+ * @param map [in,out]       - pointer to map,
+ * @param radius [in]        - distance between cities,
+ * @param city2 [in]         - pointer to last city,
+ * @param found [in]         - pointer to set of found paths,
+ * @param deviation [in]     - number of spur city of last found path,
+ * @param arrays [in]        - last found path split into arrays,
+ * @param state [in,out]     - pointer to state of found paths,
+ * @param candidates [in,out] - pointer to set of candidates.
+ * @return Value @p true if candidates were added. Value @p false if
+ * allocation error occurred.
+ */
+static bool addCandidates(Map *map, unsigned radius, City *city2,
+                          path_set_t *found, size_t deviation,
+                          path_arrays_t *arrays, prefix_state_t *state,
+                          path_set_t *candidates) {
+    unsigned root_len = 0;
+    int root_year = INT_MAX;
+    path_status_t status;
+    path_t *spur_path;
+
+    for (size_t i = 0; i < arrays->roads_num; i++) {
+        Road *curr_road = arrays->roads[i];
+
+        if (i >= deviation) {
+            spur_path = searchSpurPath(map->workspace, map->bounds, radius,
+                                       map, arrays->cities[i], city2,
+                                       arrays->cities, i, root_len,
+                                       root_year, state->spur_roads,
+                                       collectSpurRoads(state, found->num),
+                                       &status);
+            if (status == PATH_ERROR)
+                return false;
+            if (spur_path != NULL) {
+                for (size_t j = i; j > 0; j--) {
+                    if (!addList(&spur_path->roads,
+                                 (void *) arrays->roads[j - 1])) {
+                        deletePath(spur_path);
+                        return false;
+                    }
+                }
+                if (checkIfSetContainsPath(candidates, spur_path)) {
+                    deletePath(spur_path);
+                } else if (!addPathToSet(candidates, spur_path, i)) {
+                    deletePath(spur_path);
+                    return false;
+                }
+            }
+        }
+
+        advancePrefixState(state, found->num, curr_road);
+        root_len += curr_road->length;
+        root_year = root_year < curr_road->year ? root_year : curr_road->year;
+    }
+    return true;
+}
+
+/** @brief Finds k shortest loopless paths between two cities.
+ * Paths are sorted by length and then by year of oldest road descending.
+ * Paths with equal length and year are in order in which they were found.
+ * @param map [in,out]       - pointer to map,
+ * @param city1 [in]         - pointer to first city,
+ * @param city2 [in]         - pointer to last city, different from
+ *                             @p city1,
+ * @param k [in]             - maximal number of paths,
+ * @param paths_num [out]    - number of found paths,
+ * @param status [out]       - result of search.
+ * @return Array of found paths, which has to be deleted by
+ * @ref deletePaths, or NULL if cities aren't connected or allocation error
+ * occurred.
+ */
+path_t **findKShortestPaths(Map *map, City *city1, City *city2, unsigned k,
+                            size_t *paths_num, path_status_t *status) {
+    path_set_t found = {NULL, NULL, 0, 0}, candidates = {NULL, NULL, 0, 0};
+    path_arrays_t arrays = {NULL, NULL, 0, 0};
+    prefix_state_t state = {NULL, NULL, NULL, 0};
+    path_t *path;
+    size_t deviation = 0;
+    unsigned radius;
+
+    *paths_num = 0;
+    radius = searchLowerBounds(map->bounds, map, city2, city1, status);
+    if (*status != PATH_FOUND)
+        return NULL;
+
+    path = searchSpurPath(map->workspace, map->bounds, radius, map, city1,
+                          city2, NULL, 0, 0, INT_MAX, NULL, 0, status);
+    while (path != NULL) {
+        if (!addPathToSet(&found, path, deviation)) {
+            deletePath(path);
+            *status = PATH_ERROR;
+            break;
+        }
+        if (found.num == k)
+            break;
+        if (!splitPath(&arrays, path, city1) ||
+            !resetPrefixState(&state, &found) ||
+            !addCandidates(map, radius, city2, &found, deviation, &arrays,
+                           &state, &candidates)) {
+            *status = PATH_ERROR;
+            break;
+        }
+        path = candidates.num == 0
+               ? NULL : removeBestPathFromSet(&candidates, &deviation);
+    }
+
+    for (size_t i = 0; i < candidates.num; i++)
+        deletePath(candidates.paths[i]);
+    MEMORY_FREE(MEMORY_PATH, candidates.paths);
+    MEMORY_FREE(MEMORY_PATH, candidates.deviations);
+    MEMORY_FREE(MEMORY_PATH, found.deviations);
+    MEMORY_FREE(MEMORY_PATH, arrays.cities);
+    MEMORY_FREE(MEMORY_PATH, arrays.roads);
+    MEMORY_FREE(MEMORY_PATH, state.cursors);
+    MEMORY_FREE(MEMORY_PATH, state.shared);
+    MEMORY_FREE(MEMORY_PATH, state.spur_roads);
+
+    if (*status != PATH_FOUND) {
+        deletePaths(found.paths, found.num);
+        return NULL;
+    }
+    *paths_num = found.num;
+    return found.paths;
+}
@@ -0,0 +1,18 @@
+/** @file
+ * Interface of module finding k shortest loopless paths between two cities.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_K_PATHS_H
+#define ROADS_K_PATHS_H
+
+#include <stddef.h>
+
+#include "roads_types.h"
+
+path_t **findKShortestPaths(Map *map, City *city1, City *city2, unsigned k,
+                            size_t *paths_num, path_status_t *status);
+
+#endif //ROADS_K_PATHS_H
@@ -6,6 +6,7 @@
  */
 
 #include "list.h"
+#include "memory_stats.h"
 
 #include <stdbool.h>
 #include <stdlib.h>
@@ -14,7 +15,7 @@
  * @return Pointer to new empty list or NULL if allocation problem occurred.
  */
 list_t* newList(){
-    list_t *list = (list_t*)malloc(sizeof(list_t));
+    list_t *list = (list_t*)MEMORY_ALLOC(MEMORY_LIST, sizeof(list_t));
     if (list == NULL)
         return NULL;
     list->next = NULL;
@@ -28,7 +29,7 @@ list_t* newList(){
  * @return Value @p true if element was added, otherwise value @p false.
  */
 bool addList(list_t **head, void *value){
-    list_t *node = (list_t*)malloc(sizeof(list_t));
+    list_t *node = (list_t*)MEMORY_ALLOC(MEMORY_LIST, sizeof(list_t));
     if (node == NULL)
         return false;
     node->next = *head;
@@ -67,7 +68,7 @@ bool removeList(list_t **head, void *value){
                 prev->next = tmpNode->next;
             else
                 *head = tmpNode->next;
-            free(tmpNode);
+            MEMORY_FREE(MEMORY_LIST, tmpNode);
             return true;
         }
         prev = tmpNode;
@@ -86,7 +87,7 @@ void* removeHeadList(list_t **head){
         return NULL;
     void *value = tmpNode->value;
     *head = tmpNode->next;
-    free(tmpNode);
+    MEMORY_FREE(MEMORY_LIST, tmpNode);
     return value;
 }
 
@@ -98,7 +99,7 @@ void deleteList(list_t **head){
     list_t *next;
     while (tmpNode != NULL){
         next = tmpNode->next;
-        free(tmpNode);
+        MEMORY_FREE(MEMORY_LIST, tmpNode);
         tmpNode = next;
     }
     *head = NULL;
@@ -6,18 +6,31 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "map.h"
+#include "bridges.h"
 #include "city.h"
+#include "connectivity.h"
+#include "distance_matrix.h"
+#include "diversions.h"
+#include "k_paths.h"
+#include "memory_stats.h"
 #include "path.h"
 #include "road.h"
+#include "road_index.h"
 #include "route.h"
+#include "search.h"
+#include "search_stats.h"
 #include "utils.h"
 
 /** @brief Marks that all roads from list are part of route.
+ * Roads are also added to index of roads of route.
  * Do nothing if error occurred.
  * @param roads [in]      - double pointer to list,
  * @param route [in]      - pointer to list.
@@ -28,10 +41,14 @@ static bool markAllRoadsFromList(list_t **roads, Route *route) {
     list_t *tmpNode = *roads;
 
     while (tmpNode != NULL && tmpNode->value != NULL) {
-        if (!markRoadAsPartOfRoute((Road *) tmpNode->value, route)) {
+        if (!markRoadAsPartOfRoute((Road *) tmpNode->value, route) ||
+            !indexRouteRoad(route, (Road *) tmpNode->value)) {
+            // Road could be marked, but not added to index.
+            unmarkRoadAsPartOfRoute((Road *) tmpNode->value, route);
             tmpNode = *roads;
             for (int j = 0; j < i; j++) {
                 unmarkRoadAsPartOfRoute((Road *) tmpNode->value, route);
+                unindexRouteRoad(route, (Road *) tmpNode->value);
                 tmpNode = tmpNode->next;
             }
             return false;
@@ -44,6 +61,7 @@ static bool markAllRoadsFromList(list_t **roads, Route *route) {
 }
 
 /** @brief Marks that all roads from list are not longer part of route.
+ * Roads are also removed from index of roads of route.
  * @param roads [in]      - double pointer to list,
  * @param route [in]      - pointer to route.
  */
@@ -51,31 +69,70 @@ static void unmarkAllRoadsFromList(list_t **roads, Route *route) {
     list_t *tmp_node = *roads;
     while (tmp_node != NULL && tmp_node->value != NULL) {
         unmarkRoadAsPartOfRoute((Road *) tmp_node->value, route);
+        unindexRouteRoad(route, (Road *) tmp_node->value);
         tmp_node = tmp_node->next;
     }
 }
 
+/** @brief Finds city with given name.
+ * @param map [in,out]    - pointer to map,
+ * @param name [in]       - pointer to city name.
+ * @return Pointer to city or NULL if city doesn't exist.
+ */
+static City *findCity(Map *map, const char *name) {
+    const char *handle = namePoolFind(map->names, name);
+
+    if (handle == NULL)
+        return NULL;
+    return (City *) mapGet(map->cities, (void *) handle);
+}
+
 /** @brief Creates new structure.
  * Creates new empty structure doesn't containing any cities, roads and routes.
  * @return Pointer to new structure or NULL if allocation error occurred.
  */
 Map *newMap(void) {
-    Map *new_map = (Map *) malloc(sizeof(Map));
+    Map *new_map = (Map *) MEMORY_ALLOC(MEMORY_MAP, sizeof(Map));
 
     if (new_map == NULL)
         return NULL;
 
-    new_map->cities = mapInit(cityNameCmp, cityNameEq, printCityName,
-                              free, deleteCityFromAvlMap);
+    new_map->names = namePoolInit();
+    if (new_map->names == NULL) {
+        MEMORY_FREE(MEMORY_MAP, new_map);
+        return NULL;
+    }
+
+    // Keys are handles owned by pool of names, so they are never freed.
+    new_map->cities = mapInit(cityHandleCmp, cityHandleEq, printCityName,
+                              NULL, deleteCityFromAvlMap);
     if (new_map->cities == NULL) {
-        free(new_map);
+        namePoolDelete(new_map->names);
+        MEMORY_FREE(MEMORY_MAP, new_map);
+        return NULL;
+    }
+
+    new_map->connectivity = createConnectivity();
+    new_map->workspace = createSearchWorkspace();
+    new_map->bounds = createSearchWorkspace();
+    if (new_map->connectivity == NULL || new_map->workspace == NULL ||
+        new_map->bounds == NULL) {
+        deleteConnectivity(new_map->connectivity);
+        deleteSearchWorkspace(new_map->workspace);
+        deleteSearchWorkspace(new_map->bounds);
+        mapDelete(new_map->cities, 2);
+        namePoolDelete(new_map->names);
+        MEMORY_FREE(MEMORY_MAP, new_map);
         return NULL;
     }
 
     for (unsigned i = 0; i < 1000; i++)
         new_map->routes[i] = NULL;
 
+    new_map->roads_index = NULL;
     new_map->cities_num = 0;
+    new_map->bridges_stamp = 0;
+    new_map->bridges_cycle_stamp = 0;
     return new_map;
 }
 
@@ -94,7 +151,11 @@ void deleteMap(Map *map) {
     }
 
     mapDelete(map->cities, 2);
-    free(map);
+    namePoolDelete(map->names);
+    deleteConnectivity(map->connectivity);
+    deleteSearchWorkspace(map->workspace);
+    deleteSearchWorkspace(map->bounds);
+    MEMORY_FREE(MEMORY_MAP, map);
 }
 
 /** @brief Adds new road between two cities.
@@ -112,7 +173,7 @@ bool addRoad(Map *map, const char *city1, const char *city2,
              unsigned length, int builtYear) {
     City *cities[2];
     Road *road;
-    char *cities_name[2];
+    const char *cities_name[2];
     bool created_cities[2] = {false, false};
 
     if (!checkCityName(city1) || !checkCityName(city2) ||
@@ -124,14 +185,14 @@ bool addRoad(Map *map, const char *city1, const char *city2,
     if (strcmp(city1, city2) == 0)
         return false;
 
-    cities[0] = (City *) mapGet(map->cities, (void *) city1);
-    cities[1] = (City *) mapGet(map->cities, (void *) city2);
+    cities[0] = findCity(map, city1);
+    cities[1] = findCity(map, city2);
 
     // Creating cities if cities don't exist.
     for (int i = 0; i < 2; i++) {
         if (cities[i] == NULL) {
-            cities_name[i] = malloc(
-                    sizeof(char) * (strlen(i == 0 ? city1 : city2) + 1));
+            cities_name[i] = namePoolIntern(map->names,
+                                            i == 0 ? city1 : city2);
             if (cities_name[i] == NULL) {
                 if (i == 1 && created_cities[0]) {
                     map->cities_num--;
@@ -139,10 +200,8 @@ bool addRoad(Map *map, const char *city1, const char *city2,
                 }
                 return false;
             }
-            strcpy(cities_name[i], i == 0 ? city1 : city2);
-            cities[i] = createCity(cities_name[i]);
+            cities[i] = createCity(cities_name[i], map->cities_num);
             if (cities[i] == NULL) {
-                free(cities_name[i]);
                 if (i == 1 && created_cities[0]) {
                     map->cities_num--;
                     deleteCity(cities[0]);
@@ -157,7 +216,7 @@ bool addRoad(Map *map, const char *city1, const char *city2,
     assert(cities[0] != NULL);
     assert(cities[1] != NULL);
 
-    road = mapGet(cities[0]->connected_roads, (void *) city2);
+    road = getRoadToCity(cities[0], cities[1]);
 
     if (road != NULL) {
         road = NULL;
@@ -210,9 +269,369 @@ bool addRoad(Map *map, const char *city1, const char *city2,
         }
     }
 
+    updateBridgesAfterAddingRoad(map, road, created_cities[0],
+                                 created_cities[1]);
+    joinCitiesInConnectivity(map, cities[0], cities[1]);
+    indexRoad(&map->roads_index, road);
     return true;
 }
 
+/**
+ * Structure describing road accepted by @ref addRoads.
+ * Cities are ordered by addresses of handles of their names. Name of city,
+ * which doesn't exist in map, is handle in pool of names of new cities.
+ */
+typedef struct bulk_road {
+    City *cities[2];        /**< Pointers to cities or NULL if city is new. */
+    const char *names[2];   /**< Handles of city names. */
+    size_t index;           /**< Position of road description. */
+    bool reversed;          /**< Flag indicating if cities are in reversed
+                                 order in road description. */
+} bulk_road_t;
+
+/**
+ * Structure describing city created by @ref addRoads.
+ */
+typedef struct bulk_city {
+    const char *name;       /**< Handle in pool of names of new cities. */
+    unsigned id;            /**< Number of city. */
+    City *city;             /**< Pointer to city. */
+} bulk_city_t;
+
+/**
+ * Structure describing end of road added by @ref addRoads.
+ */
+typedef struct bulk_end {
+    City *city;             /**< Pointer to city. */
+    unsigned next_id;       /**< Number of second city. */
+    Road *road;             /**< Pointer to road. */
+} bulk_end_t;
+
+/**
+ * Structure describing key of road added by @ref addRoads in index of roads.
+ */
+typedef struct bulk_key {
+    int year;               /**< Year of road. */
+    unsigned ids[2];        /**< Numbers of cities of road. */
+    Road *road;             /**< Pointer to road. */
+} bulk_key_t;
+
+/** @brief Compares roads by handles of city names and position.
+ * Used only by qsort in @ref addRoads.
+ * @param ptr1 [in]       - pointer to first road,
+ * @param ptr2 [in]       - pointer to second road.
+ * @return Negative value if first road comes first, positive if second road
+ * comes first, @p 0 if roads are equal.
+ */
+static int compareBulkRoads(const void *ptr1, const void *ptr2) {
+    const bulk_road_t *road1 = (const bulk_road_t *) ptr1;
+    const bulk_road_t *road2 = (const bulk_road_t *) ptr2;
+
+    for (int i = 0; i < 2; i++) {
+        if (road1->names[i] != road2->names[i])
+            return (uintptr_t) road1->names[i] < (uintptr_t) road2->names[i]
+                   ? -1 : 1;
+    }
+    if (road1->index != road2->index)
+        return road1->index < road2->index ? -1 : 1;
+    return 0;
+}
+
+/** @brief Compares new cities by handles of names in pool of new cities.
+ * Used only by qsort and bsearch in @ref addRoads.
+ * @param ptr1 [in]       - pointer to first city,
+ * @param ptr2 [in]       - pointer to second city.
+ * @return Negative value if first city comes first, positive if second city
+ * comes first, @p 0 if cities are equal.
+ */
+static int compareBulkCities(const void *ptr1, const void *ptr2) {
+    uintptr_t name1 = (uintptr_t) ((const bulk_city_t *) ptr1)->name;
+    uintptr_t name2 = (uintptr_t) ((const bulk_city_t *) ptr2)->name;
+
+    return name1 < name2 ? -1 : (name1 > name2 ? 1 : 0);
+}
+
+/** @brief Compares cities by handles of their names.
+ * Used only by qsort in @ref addRoads.
+ * @param ptr1 [in]       - pointer to pointer to first city,
+ * @param ptr2 [in]       - pointer to pointer to second city.
+ * @return Negative value if first city comes first, positive if second city
+ * comes first, @p 0 if cities are equal.
+ */
+static int compareCityHandles(const void *ptr1, const void *ptr2) {
+    uintptr_t name1 = (uintptr_t) (*(City *const *) ptr1)->name;
+    uintptr_t name2 = (uintptr_t) (*(City *const *) ptr2)->name;
+
+    return name1 < name2 ? -1 : (name1 > name2 ? 1 : 0);
+}
+
+/** @brief Compares ends of roads by number of city and second city.
+ * Used only by qsort in @ref addRoads.
+ * @param ptr1 [in]       - pointer to first end,
+ * @param ptr2 [in]       - pointer to second end.
+ * @return Negative value if first end comes first, positive if second end
+ * comes first, @p 0 if ends are equal.
+ */
+static int compareBulkEnds(const void *ptr1, const void *ptr2) {
+    const bulk_end_t *end1 = (const bulk_end_t *) ptr1;
+    const bulk_end_t *end2 = (const bulk_end_t *) ptr2;
+
+    if (end1->city->id != end2->city->id)
+        return end1->city->id < end2->city->id ? -1 : 1;
+    if (end1->next_id != end2->next_id)
+        return end1->next_id < end2->next_id ? -1 : 1;
+    return 0;
+}
+
+/** @brief Compares keys of roads in index of roads.
+ * Used only by qsort in @ref addRoads.
+ * @param ptr1 [in]       - pointer to first key,
+ * @param ptr2 [in]       - pointer to second key.
+ * @return Negative value if first key comes first, positive if second key
+ * comes first, @p 0 if keys are equal.
+ */
+static int compareBulkKeys(const void *ptr1, const void *ptr2) {
+    const bulk_key_t *key1 = (const bulk_key_t *) ptr1;
+    const bulk_key_t *key2 = (const bulk_key_t *) ptr2;
+
+    if (key1->year != key2->year)
+        return key1->year < key2->year ? -1 : 1;
+    for (int i = 0; i < 2; i++) {
+        if (key1->ids[i] != key2->ids[i])
+            return key1->ids[i] < key2->ids[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+/** @brief Finds city created by @ref addRoads.
+ * @param cities [in]     - array of new cities sorted by names,
+ * @param num [in]        - number of new cities,
+ * @param name [in]       - handle in pool of names of new cities.
+ * @return Pointer to new city description.
+ */
+static bulk_city_t *findNewCity(bulk_city_t *cities, size_t num,
+                                const char *name) {
+    bulk_city_t key = {name, 0, NULL};
+    bulk_city_t *found = (bulk_city_t *) bsearch(&key, cities, num,
+                                                 sizeof(bulk_city_t),
+                                                 compareBulkCities);
+    assert(found != NULL);
+    return found;
+}
+
+/** @brief Adds many roads at once.
+ * Result is the same as if @ref addRoad was called for every road in array
+ * order: road isn't added if any parameter has invalid value, cities are
+ * the same or road between these cities already exists in map or earlier
+ * in array. Roads keep order of their cities and new cities get numbers in
+ * order of their first appearance. Roads are sorted and deduplicated first,
+ * then new cities are inserted to map and roads to cities in one pass for
+ * every structure. Names of new cities are kept in temporary pool until
+ * roads are validated, so rejected roads don't add names to map.
+ * @param map [in,out]    - pointer to map,
+ * @param roads [in]      - array of road descriptions,
+ * @param roads_num [in]  - number of road descriptions,
+ * @param added [out]     - array of flags indicating if road was added.
+ * @return Value @p true if roads were processed. Value @p false if
+ * allocation error occurred, then map isn't modified.
+ */
+bool addRoads(Map *map, const road_desc_t *roads, size_t roads_num,
+              bool *added) {
+    name_pool_t *new_names = NULL;
+    bulk_road_t *accepted = NULL;
+    bulk_city_t *new_cities = NULL;
+    bulk_end_t *ends = NULL;
+    bulk_key_t *keys = NULL;
+    const char **handles = NULL;
+    City **sorted_cities = NULL, *cities[2];
+    Road **ends_roads = NULL;
+    size_t accepted_num = 0, kept_num = 0, pool_size, cities_num = 0;
+    size_t created_num = 0, roads_added = 0, i, j;
+    bool result = false;
+
+    if (map == NULL)
+        return false;
+
+    new_names = namePoolInit();
+    accepted = (bulk_road_t *) MEMORY_ALLOC(
+            MEMORY_MAP, sizeof(bulk_road_t) * (roads_num + 1));
+    new_cities = (bulk_city_t *) MEMORY_ALLOC(
+            MEMORY_MAP, sizeof(bulk_city_t) * (2 * roads_num + 1));
+    if (new_names == NULL || accepted == NULL || new_cities == NULL)
+        goto cleanup;
+
+    // Validating roads and finding their cities.
+    for (i = 0; i < roads_num; i++) {
+        bulk_road_t *road = &accepted[accepted_num];
+
+        added[i] = false;
+        if (!checkCityName(roads[i].city1) || !checkCityName(roads[i].city2) ||
+            !checkLength(roads[i].length) || !checkYear(roads[i].year) ||
+            strcmp(roads[i].city1, roads[i].city2) == 0)
+            continue;
+
+        for (j = 0; j < 2; j++) {
+            const char *name = j == 0 ? roads[i].city1 : roads[i].city2;
+
+            road->cities[j] = findCity(map, name);
+            if (road->cities[j] != NULL) {
+                road->names[j] = road->cities[j]->name;
+                continue;
+            }
+
+            pool_size = new_names->size;
+            road->names[j] = namePoolIntern(new_names, name);
+            if (road->names[j] == NULL)
+                goto cleanup;
+            // Numbering new cities in order of their first appearance.
+            if (new_names->size > pool_size) {
+                new_cities[cities_num].name = road->names[j];
+                new_cities[cities_num].id = map->cities_num +
+                                            (unsigned) cities_num;
+                cities_num++;
+            }
+        }
+        road->reversed = (uintptr_t) road->names[0] >
+                         (uintptr_t) road->names[1];
+        if (road->reversed) {
+            const char *name = road->names[0];
+
+            cities[0] = road->cities[0];
+            road->cities[0] = road->cities[1];
+            road->cities[1] = cities[0];
+            road->names[0] = road->names[1];
+            road->names[1] = name;
+        }
+        road->index = i;
+        accepted_num++;
+    }
+
+    // Leaving only first road between every pair of cities, which aren't
+    // connected in map yet. Roads are moved only to lower positions, so
+    // previous road is never overwritten.
+    qsort(accepted, accepted_num, sizeof(bulk_road_t), compareBulkRoads);
+    for (i = 0; i < accepted_num; i++) {
+        if (i > 0 && accepted[i - 1].names[0] == accepted[i].names[0] &&
+            accepted[i - 1].names[1] == accepted[i].names[1])
+            continue;
+        if (accepted[i].cities[0] != NULL && accepted[i].cities[1] != NULL &&
+            getRoadToCity(accepted[i].cities[0],
+                          accepted[i].cities[1]) != NULL)
+            continue;
+        accepted[kept_num++] = accepted[i];
+    }
+
+    // Every new city appears first in kept road, so all of them are created.
+    qsort(new_cities, cities_num, sizeof(bulk_city_t), compareBulkCities);
+
+    handles = (const char **) MEMORY_ALLOC(
+            MEMORY_MAP, sizeof(const char *) * (cities_num + 1));
+    sorted_cities = (City **) MEMORY_ALLOC(MEMORY_MAP,
+                                           sizeof(City *) * (cities_num + 1));
+    keys = (bulk_key_t *) MEMORY_ALLOC(MEMORY_MAP,
+                                       sizeof(bulk_key_t) * (kept_num + 1));
+    ends = (bulk_end_t *) MEMORY_ALLOC(MEMORY_MAP, sizeof(bulk_end_t) *
+                                                   (2 * kept_num + 1));
+    ends_roads = (Road **) MEMORY_ALLOC(MEMORY_MAP, sizeof(Road *) *
+                                                    (2 * kept_num + 1));
+    if (handles == NULL || sorted_cities == NULL || keys == NULL ||
+        ends == NULL || ends_roads == NULL)
+        goto cleanup;
+
+    // Creating new cities, only now their names are added to map.
+    for (; created_num < cities_num; created_num++) {
+        const char *handle = namePoolIntern(map->names,
+                                            new_cities[created_num].name);
+
+        new_cities[created_num].city =
+                handle == NULL ? NULL : createCity(handle,
+                                                   new_cities[created_num].id);
+        if (new_cities[created_num].city == NULL)
+            goto rollback;
+        sorted_cities[created_num] = new_cities[created_num].city;
+    }
+
+    // Creating roads with cities in order of road descriptions.
+    for (i = 0; i < kept_num; i++) {
+        const road_desc_t *desc = &roads[accepted[i].index];
+        Road *road;
+
+        for (j = 0; j < 2; j++) {
+            cities[j ^ accepted[i].reversed] = accepted[i].cities[j] != NULL
+                    ? accepted[i].cities[j]
+                    : findNewCity(new_cities, cities_num,
+                                  accepted[i].names[j])->city;
+        }
+        road = createRoad(cities[0], cities[1], desc->length, desc->year);
+        if (road == NULL)
+            goto rollback;
+        keys[roads_added].year = desc->year;
+        for (j = 0; j < 2; j++) {
+            keys[roads_added].ids[j] = cities[j]->id;
+            ends[2 * roads_added + j].city = cities[j];
+            ends[2 * roads_added + j].next_id = cities[1 - j]->id;
+            ends[2 * roads_added + j].road = road;
+        }
+        keys[roads_added].road = road;
+        roads_added++;
+    }
+
+    // Reserving space for roads in every city.
+    qsort(ends, 2 * roads_added, sizeof(bulk_end_t), compareBulkEnds);
+    for (i = 0; i < 2 * roads_added; i = j) {
+        for (j = i; j < 2 * roads_added && ends[j].city == ends[i].city; j++)
+            ends_roads[j] = ends[j].road;
+        if (!reserveRoadsInCity(ends[i].city,
+                                ends[i].city->roads_num + (unsigned) (j - i)))
+            goto rollback;
+    }
+
+    // Inserting new cities, sorted by handle as keys in map of cities.
+    qsort(sorted_cities, cities_num, sizeof(City *), compareCityHandles);
+    for (i = 0; i < cities_num; i++)
+        handles[i] = sorted_cities[i]->name;
+    if (!mapBulkInsert(map->cities, (void **) handles,
+                       (void **) sorted_cities, cities_num))
+        goto rollback;
+
+    // From now on nothing can fail.
+    for (i = 0; i < 2 * roads_added; i = j) {
+        for (j = i; j < 2 * roads_added && ends[j].city == ends[i].city; j++);
+        mergeRoadsIntoCity(ends[i].city, ends_roads + i, (unsigned) (j - i));
+    }
+    for (i = 0; i < kept_num; i++)
+        added[accepted[i].index] = true;
+    map->cities_num += (unsigned) cities_num;
+    invalidateBridges(map);
+    // Roads are inserted to index in its order, so consecutive insertions
+    // visit the same nodes.
+    qsort(keys, roads_added, sizeof(bulk_key_t), compareBulkKeys);
+    for (i = 0; i < roads_added; i++) {
+        joinCitiesInConnectivity(map, keys[i].road->city1,
+                                 keys[i].road->city2);
+        indexRoad(&map->roads_index, keys[i].road);
+    }
+    result = true;
+    goto cleanup;
+
+    rollback:
+    for (i = 0; i < roads_added; i++)
+        deleteRoad(keys[i].road);
+    for (i = 0; i < created_num; i++)
+        deleteCity(new_cities[i].city);
+
+    cleanup:
+    namePoolDelete(new_names);
+    MEMORY_FREE(MEMORY_MAP, accepted);
+    MEMORY_FREE(MEMORY_MAP, new_cities);
+    MEMORY_FREE(MEMORY_MAP, handles);
+    MEMORY_FREE(MEMORY_MAP, sorted_cities);
+    MEMORY_FREE(MEMORY_MAP, keys);
+    MEMORY_FREE(MEMORY_MAP, ends);
+    MEMORY_FREE(MEMORY_MAP, ends_roads);
+    return result;
+}
+
 /** @brief Modifies year of last road repair.
  * For road between two specified cities, changes last repair year or sets it
  * if it's first repair.
@@ -239,20 +658,23 @@ repairRoad(Map *map, const char *city1, const char *city2, int repairYear) {
     if (strcmp(city1, city2) == 0)
         return false;
 
-    cities[0] = (City *) mapGet(map->cities, (void *) city1);
-    cities[1] = (City *) mapGet(map->cities, (void *) city2);
+    cities[0] = findCity(map, city1);
+    cities[1] = findCity(map, city2);
 
     // Checking if cities exist.
     if (cities[0] == NULL || cities[1] == NULL)
         return false;
 
-    road = (Road *) mapGet(cities[0]->connected_roads,
-                           (void *) cities[1]->name);
+    road = getRoadToCity(cities[0], cities[1]);
     // Checking if road exists.
     if (road == NULL)
         return false;
 
-    return repairSelectedRoad(road, repairYear);
+    if (!repairSelectedRoad(road, repairYear))
+        return false;
+
+    reindexRoad(&map->roads_index, road);
+    return true;
 }
 
 /** @brief Creates route connecting specified cities.
@@ -287,8 +709,8 @@ bool newRoute(Map *map, unsigned routeId,
     if (map->routes[routeId] != NULL)
         return false;
 
-    cities[0] = (City *) mapGet(map->cities, (void *) city1);
-    cities[1] = (City *) mapGet(map->cities, (void *) city2);
+    cities[0] = findCity(map, city1);
+    cities[1] = findCity(map, city2);
 
     // Checking if cities exists.
     for (int i = 0; i < 2; i++) {
@@ -299,6 +721,12 @@ bool newRoute(Map *map, unsigned routeId,
     assert(cities[0] != NULL);
     assert(cities[1] != NULL);
 
+    // Checking if cities are in the same component.
+    if (!checkIfCitiesMayBeConnected(map, cities[0], cities[1])) {
+        SEARCH_STATS_ADD(component_rejects, 1);
+        return false;
+    }
+
     // Finding best path connecting these cities.
     path = findBestPath(map, cities[0], cities[1], NULL, true);
     // Checking if any path exists.
@@ -309,9 +737,10 @@ bool newRoute(Map *map, unsigned routeId,
     if (checkIfPathDefinedUnambiguously(map, path, cities[0], cities[1],
                                         NULL, true)) {
         roads = path->roads;
-        free(path);
+        MEMORY_FREE(MEMORY_PATH, path);
     } else {
-        free(path);
+        deleteList(&path->roads);
+        MEMORY_FREE(MEMORY_PATH, path);
         return false;
     }
 
@@ -359,7 +788,7 @@ bool extendRoute(Map *map, unsigned routeId, const char *city) {
         return false;
 
     // Checking if city exists.
-    extend_city = (City *) mapGet(map->cities, (void *) city);
+    extend_city = findCity(map, city);
     if (extend_city == NULL)
         return false;
 
@@ -370,6 +799,12 @@ bool extendRoute(Map *map, unsigned routeId, const char *city) {
     cities[0] = route->firstCity;
     cities[1] = route->lastCity;
 
+    // Checking if city is in the same component as route.
+    if (!checkIfCitiesMayBeConnected(map, extend_city, cities[0])) {
+        SEARCH_STATS_ADD(component_rejects, 1);
+        return false;
+    }
+
     // Finding possibilities of extending route in both directions.
     paths[0] = findBestPath(map, extend_city, cities[0], &route->roads, true);
     paths[1] = findBestPath(map, cities[1], extend_city, &route->roads, true);
@@ -414,7 +849,7 @@ bool extendRoute(Map *map, unsigned routeId, const char *city) {
         if (paths[i] != NULL) {
             if (paths[i]->roads != selected_roads)
                 deleteList(&paths[i]->roads);
-            free(paths[i]);
+            MEMORY_FREE(MEMORY_PATH, paths[i]);
         }
     }
     if (selected_roads == NULL)
@@ -454,7 +889,7 @@ bool removeRoad(Map *map, const char *city1, const char *city2) {
     Road *road;
     Route *curr_route;
     Route **routes;
-    list_t *tmp_node;
+    Route **road_routes;
     path_t **paths;
     unsigned routes_num;
     bool city1_first;
@@ -465,34 +900,41 @@ bool removeRoad(Map *map, const char *city1, const char *city2) {
     if (strcmp(city1, city2) == 0)
         return false;
 
-    cities[0] = (City *) mapGet(map->cities, (void *) city1);
-    cities[1] = (City *) mapGet(map->cities, (void *) city2);
+    cities[0] = findCity(map, city1);
+    cities[1] = findCity(map, city2);
 
     // Checking if cities exist.
     if (cities[0] == NULL || cities[1] == NULL)
         return false;
 
-    road = (Road *) mapGet(cities[0]->connected_roads,
-                           (void *) cities[1]->name);
+    road = getRoadToCity(cities[0], cities[1]);
     // Checking if road exists.
     if (road == NULL)
         return false;
 
     routes_num = road->routes_num;
-    paths = (path_t **) malloc(sizeof(path_t *) * routes_num);
+    // Road without diversion can't be removed from any route.
+    if (routes_num > 0 && checkIfRoadIsKnownBridge(map, road)) {
+        SEARCH_STATS_ADD(bridge_rejects, 1);
+        return false;
+    }
+    SEARCH_STATS_ADD(routes, routes_num);
+    paths = (path_t **) MEMORY_ALLOC(MEMORY_MAP,
+                                     sizeof(path_t *) * routes_num);
     if (paths == NULL)
         return false;
 
-    routes = (Route **) malloc(sizeof(Route *) * routes_num);
+    routes = (Route **) MEMORY_ALLOC(MEMORY_MAP,
+                                     sizeof(Route *) * routes_num);
     if (routes == NULL) {
-        free(paths);
+        MEMORY_FREE(MEMORY_MAP, paths);
         return false;
     }
 
     // Finding unambiguous diversion for every affected route.
-    tmp_node = road->partOfRoute;
+    road_routes = getRoadRoutes(road);
     for (unsigned i = 0; i < routes_num; i++) {
-        curr_route = (Route *) tmp_node->value;
+        curr_route = road_routes[i];
         assert(curr_route != NULL);
         city1_first = checkIfFirstCityComesFirst(curr_route, cities[0],
                                                  cities[1]);
@@ -507,12 +949,13 @@ bool removeRoad(Map *map, const char *city1, const char *city2) {
 
         if (paths[i] == NULL) {
             for (unsigned j = i; j > 0; j--) {
-                deleteList(&paths[j - 1]->roads);
                 unmarkAllRoadsFromList(&paths[j - 1]->roads, routes[j - 1]);
-                free(paths[j - 1]);
+                deleteList(&paths[j - 1]->roads);
+                MEMORY_FREE(MEMORY_PATH, paths[j - 1]);
             }
-            free(routes);
-            free(paths);
+            MEMORY_FREE(MEMORY_MAP, routes);
+            MEMORY_FREE(MEMORY_MAP, paths);
+            updateBridgesAfterMissingDiversion(map, road);
             return false;
         }
 
@@ -530,49 +973,191 @@ bool removeRoad(Map *map, const char *city1, const char *city2) {
         }
         if (!unambiguous) {
             for (unsigned j = i + 1; j > 0; j--) {
-                deleteList(&paths[j - 1]->roads);
                 if (j != i + 1)
                     unmarkAllRoadsFromList(&paths[j - 1]->roads, routes[j - 1]);
-                free(paths[j - 1]);
+                deleteList(&paths[j - 1]->roads);
+                MEMORY_FREE(MEMORY_PATH, paths[j - 1]);
             }
-            free(paths);
-            free(routes);
+            MEMORY_FREE(MEMORY_MAP, paths);
+            MEMORY_FREE(MEMORY_MAP, routes);
             return false;
         }
         if (!markAllRoadsFromList(&paths[i]->roads, curr_route)) {
             for (unsigned j = i + 1; j > 0; j--) {
-                deleteList(&paths[j - 1]->roads);
                 if (j != i + 1)
                     unmarkAllRoadsFromList(&paths[j - 1]->roads, routes[j - 1]);
-                free(paths[j - 1]);
+                deleteList(&paths[j - 1]->roads);
+                MEMORY_FREE(MEMORY_PATH, paths[j - 1]);
             }
-            free(paths);
-            free(routes);
+            MEMORY_FREE(MEMORY_MAP, paths);
+            MEMORY_FREE(MEMORY_MAP, routes);
             return false;
         }
         routes[i] = curr_route;
-        tmp_node = tmp_node->next;
     }
 
-    tmp_node = road->partOfRoute;
     for (unsigned i = 0; i < routes_num; i++) {
-        curr_route = (Route *) tmp_node->value;
+        curr_route = routes[i];
 
         assert(curr_route != NULL);
         replaceRoad(curr_route, road, &paths[i]->roads);
+        unindexRouteRoad(curr_route, road);
 
-        free(paths[i]);
-
-        tmp_node = tmp_node->next;
+        MEMORY_FREE(MEMORY_PATH, paths[i]);
     }
-    free(paths);
-    free(routes);
+    MEMORY_FREE(MEMORY_MAP, paths);
+    MEMORY_FREE(MEMORY_MAP, routes);
+    updateBridgesBeforeRemovingRoad(map, road);
+    // Road without routes could be bridge, then its component is split.
+    if (routes_num == 0)
+        invalidateConnectivity(map);
     removeRoadFromCity(cities[0], road);
     removeRoadFromCity(cities[1], road);
+    unindexRoad(&map->roads_index, road);
     deleteRoad(road);
     return true;
 }
 
+/** @brief Compares diversions by route numbers.
+ * Used only by qsort in @ref analyzeRemoveRoad.
+ * @param ptr1 [in]       - pointer to first diversion,
+ * @param ptr2 [in]       - pointer to second diversion.
+ * @return Negative value if first diversion comes first, positive if second
+ * diversion comes first, @p 0 if routes are equal.
+ */
+static int compareDiversions(const void *ptr1, const void *ptr2) {
+    unsigned id1 = ((const diversion_t *) ptr1)->route->routeId;
+    unsigned id2 = ((const diversion_t *) ptr2)->route->routeId;
+
+    return id1 < id2 ? -1 : id1 > id2;
+}
+
+/** @brief Creates description of result of analysis of road removal.
+ * Used only by @ref analyzeRemoveRoad.
+ * @param diversions [in]     – array of diversions sorted by route number,
+ * @param diversions_num [in] – number of diversions,
+ * @param removable [in]      – flag indicating if road would be removed.
+ * @return Pointer to description or NULL if allocation error occurred.
+ */
+static char *describeDiversions(diversion_t *diversions, size_t diversions_num,
+                                bool removable) {
+    const char *verdict = removable ? "removable" : "unremovable";
+    size_t desc_len = strlen(verdict) + 1, offset;
+    char *buffer;
+
+    for (size_t i = 0; i < diversions_num; i++) {
+        desc_len += getNumberLength(diversions[i].route->routeId) + 2;
+        if (diversions[i].path != NULL) {
+            desc_len += getPathDescriptionLength(diversions[i].city1,
+                                                 diversions[i].path->roads);
+        } else {
+            desc_len += strlen("unreachable");
+        }
+    }
+    buffer = MEMORY_ALLOC(MEMORY_PATH, sizeof(char) * desc_len);
+    if (buffer == NULL)
+        return NULL;
+
+    offset = (size_t) sprintf(buffer, "%s", verdict);
+    for (size_t i = 0; i < diversions_num; i++) {
+        offset += (size_t) sprintf(buffer + offset, "\n%u;",
+                                   diversions[i].route->routeId);
+        if (diversions[i].path != NULL) {
+            fillPathDescription(diversions[i].city1, diversions[i].path->roads,
+                                buffer + offset);
+            offset += getPathDescriptionLength(diversions[i].city1,
+                                               diversions[i].path->roads);
+        } else {
+            offset += (size_t) sprintf(buffer + offset, "%s",
+                                       diversions[i].status == PATH_AMBIGUOUS
+                                       ? "ambiguous" : "unreachable");
+        }
+    }
+    return buffer;
+}
+
+/** @brief Checks how road removal would change routes.
+ * Diversion of every route containing road is searched like in
+ * @ref removeRoad, but road isn't removed and routes aren't changed.
+ * Diversions of different routes are searched in parallel.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city.
+ * @return Pointer to description, which contains line @p removable or
+ * @p unremovable, followed by line for every route containing road, sorted
+ * by route number. Line contains route number and description of diversion
+ * in format of @ref getRouteDescription without route number, or
+ * @p unreachable or @p ambiguous if diversion wasn't found. Value NULL if
+ * any parameter is invalid, any city or road doesn't exist or allocation
+ * error occurred. Description has to be freed by caller.
+ */
+char const *analyzeRemoveRoad(Map *map, const char *city1, const char *city2) {
+    City *cities[2];
+    Road *road;
+    Route **road_routes;
+    diversion_t *diversions;
+    unsigned routes_num;
+    bool city1_first, removable = true, unreachable = false;
+    char *buffer = NULL;
+
+    if (!checkCityName(city1) || !checkCityName(city2) || map == NULL)
+        return NULL;
+    if (strcmp(city1, city2) == 0)
+        return NULL;
+
+    cities[0] = findCity(map, city1);
+    cities[1] = findCity(map, city2);
+    if (cities[0] == NULL || cities[1] == NULL)
+        return NULL;
+
+    road = getRoadToCity(cities[0], cities[1]);
+    if (road == NULL)
+        return NULL;
+
+    routes_num = road->routes_num;
+    diversions = (diversion_t *) MEMORY_ALLOC(
+            MEMORY_MAP, sizeof(diversion_t) * (routes_num + 1));
+    if (diversions == NULL)
+        return NULL;
+
+    road_routes = getRoadRoutes(road);
+    for (unsigned i = 0; i < routes_num; i++) {
+        city1_first = checkIfFirstCityComesFirst(road_routes[i], cities[0],
+                                                 cities[1]);
+        diversions[i].route = road_routes[i];
+        diversions[i].city1 = cities[city1_first ? 0 : 1];
+        diversions[i].city2 = cities[city1_first ? 1 : 0];
+        diversions[i].path = NULL;
+        diversions[i].status = PATH_UNREACHABLE;
+    }
+
+    // Road without diversion can't be removed from any route.
+    if (routes_num > 0 && checkIfRoadIsKnownBridge(map, road)) {
+        SEARCH_STATS_ADD(bridge_rejects, 1);
+    } else {
+        SEARCH_STATS_ADD(routes, routes_num);
+        if (!findDiversions(map, diversions, routes_num))
+            goto cleanup;
+    }
+
+    for (unsigned i = 0; i < routes_num; i++) {
+        if (diversions[i].path == NULL)
+            removable = false;
+        if (diversions[i].status == PATH_UNREACHABLE)
+            unreachable = true;
+    }
+    if (unreachable)
+        updateBridgesAfterMissingDiversion(map, road);
+    qsort(diversions, routes_num, sizeof(diversion_t), compareDiversions);
+    buffer = describeDiversions(diversions, routes_num, removable);
+
+    cleanup:
+    for (unsigned i = 0; i < routes_num; i++)
+        deletePath(diversions[i].path);
+    MEMORY_FREE(MEMORY_MAP, diversions);
+    return buffer;
+}
+
 /** @brief Removes route with specified number.
  * Removes route with specified number, Do nothing if route doesn't exist.
  * Doesn't remove cities or roads.
@@ -592,6 +1177,7 @@ bool removeRoute(Map *map, unsigned routeId) {
         return false;
 
     map->routes[routeId] = NULL;
+    unmarkAllRoadsFromList(&route->roads, route);
     deleteRoute(route);
     return true;
 }
@@ -619,7 +1205,7 @@ char const *getRouteDescription(Map *map, unsigned routeId) {
     route = map->routes[routeId];
     // Description is empty if route doesn't exist.
     if (route == NULL) {
-        buffer = malloc(sizeof(char));
+        buffer = MEMORY_ALLOC(MEMORY_ROUTE, sizeof(char));
         if (buffer == NULL)
             return NULL;
         buffer[0] = '\0';
@@ -628,7 +1214,7 @@ char const *getRouteDescription(Map *map, unsigned routeId) {
 
     desc_len = getRouteDescriptionLength(route);
 
-    buffer = malloc(sizeof(char) * (desc_len + 1));
+    buffer = MEMORY_ALLOC(MEMORY_ROUTE, sizeof(char) * (desc_len + 1));
     if (buffer == NULL)
         return NULL;
 
@@ -638,14 +1224,413 @@ char const *getRouteDescription(Map *map, unsigned routeId) {
     return buffer;
 }
 
-/** @brief Destroys list with roads' descriptions.
- * Assumes that road's description is previously allocated char pointer.
- * @param roads           - pointer to list.
+/** @brief Creates descriptions of roads.
+ * Used only by queries about oldest roads.
+ * @param roads [in]      – array of roads,
+ * @param roads_num [in]  – number of roads.
+ * @return Pointer to descriptions of roads in format of parameters of
+ * @ref addRoad, separated by new lines, or NULL if allocation error
+ * occurred. Description is empty if there are no roads.
  */
-static void destroyRoadDescList(list_t *roads) {
-    while (!emptyList(&roads))
-        free(removeHeadList(&roads));
-    deleteList(&roads);
+static char *describeRoads(Road **roads, size_t roads_num) {
+    size_t desc_len = 1, offset = 0;
+    char *buffer;
+
+    for (size_t i = 0; i < roads_num; i++)
+        desc_len += strlen(roads[i]->city1->name) +
+                    strlen(roads[i]->city2->name) +
+                    getNumberLength(roads[i]->length) +
+                    getNumberLength(roads[i]->year) + 4;
+    buffer = MEMORY_ALLOC(MEMORY_ROAD, sizeof(char) * desc_len);
+    if (buffer == NULL)
+        return NULL;
+
+    buffer[0] = '\0';
+    for (size_t i = 0; i < roads_num; i++)
+        offset += (size_t) sprintf(buffer + offset, "%s%s;%s;%u;%d",
+                                   i == 0 ? "" : "\n",
+                                   roads[i]->city1->name,
+                                   roads[i]->city2->name, roads[i]->length,
+                                   roads[i]->year);
+    return buffer;
+}
+
+/** @brief Finds oldest roads of map.
+ * Roads are sorted by year of building or last repair, roads with equal
+ * years are sorted by number of first city of road, then by number of
+ * second city. Uses index of roads, so cost depends only on number of roads
+ * in result.
+ * @param map [in]        – pointer to map,
+ * @param k [in]          – maximal number of roads.
+ * @return Pointer to descriptions of roads in format of parameters of
+ * @ref addRoad, separated by new lines, or NULL if @p k is @p 0 or
+ * allocation error occurred. Descriptions have to be freed by caller.
+ */
+char const *getOldestRoads(Map *map, unsigned k) {
+    Road **roads;
+    size_t roads_num;
+    char *buffer;
+
+    if (map == NULL || k == 0)
+        return NULL;
+
+    roads_num = map->roads_index == NULL ? 0 : map->roads_index->size;
+    if (roads_num > k)
+        roads_num = k;
+    roads = (Road **) MEMORY_ALLOC(MEMORY_MAP,
+                                   sizeof(Road *) * (roads_num + 1));
+    if (roads == NULL)
+        return NULL;
+
+    roads_num = selectOldestIndexedRoads(map->roads_index, roads, roads_num);
+    buffer = describeRoads(roads, roads_num);
+    MEMORY_FREE(MEMORY_MAP, roads);
+    return buffer;
+}
+
+/** @brief Counts roads older than given year.
+ * Road is older if it was built or repaired last time before @p year.
+ * Counting takes logarithmic time.
+ * @param map [in]        – pointer to map,
+ * @param year [in]       – year,
+ * @param count [out]     – number of older roads.
+ * @return Value @p true if roads were counted. Value @p false if year is
+ * invalid.
+ */
+bool countRoadsOlderThan(Map *map, int year, size_t *count) {
+    if (map == NULL || !checkYear(year))
+        return false;
+
+    *count = countIndexedRoadsBefore(map->roads_index, year);
+    return true;
+}
+
+/** @brief Finds oldest road of route.
+ * Roads with equal years are chosen like in @ref getOldestRoads. Uses
+ * index of roads of route, so it doesn't visit all roads of route.
+ * @param map [in]        – pointer to map,
+ * @param routeId [in]    – route number.
+ * @return Pointer to description of road in format of parameters of
+ * @ref addRoad, empty if route doesn't exist, or NULL if route number is
+ * invalid or allocation error occurred. Description has to be freed by
+ * caller.
+ */
+char const *getOldestRouteRoad(Map *map, unsigned routeId) {
+    Road *road;
+
+    if (!checkRouteId(routeId) || map == NULL)
+        return NULL;
+
+    if (map->routes[routeId] == NULL)
+        return describeRoads(NULL, 0);
+
+    road = getOldestIndexedRoad(map->routes[routeId]->index);
+    assert(road != NULL);
+    return describeRoads(&road, 1);
+}
+
+/** @brief Finds cities reachable from city by path not longer than limit.
+ * Lengths of paths are like in @ref newRoute. Map isn't modified. Uses
+ * search workspace of map, so cost depends only on number of reached
+ * cities and their roads. If limit is @p 0, only @p city is reached.
+ * @param map [in,out]      – pointer to map,
+ * @param city [in]         – pointer to name of city,
+ * @param maxLength [in]    – maximal length of path,
+ * @param reached [out]     – array of reached cities sorted by length of
+ *                            path, including @p city, has to be freed by
+ *                            caller. City names are valid until map is
+ *                            modified,
+ * @param reached_num [out] – number of reached cities.
+ * @return Value @p true if cities were found. Value @p false if name is
+ * incorrect, city doesn't exist or allocation error occurred.
+ */
+bool findReachableCities(Map *map, const char *city, unsigned maxLength,
+                         reach_t **reached, size_t *reached_num) {
+    City *source;
+
+    if (!checkCityName(city) || map == NULL)
+        return false;
+    source = findCity(map, city);
+    if (source == NULL)
+        return false;
+
+    return searchWithinLength(map->workspace, map, source, maxLength, reached,
+                              reached_num);
+}
+
+/** @brief Creates descriptions of paths.
+ * Used only by @ref findAlternativePaths and @ref findParetoPaths.
+ * @param city1 [in]      – pointer to first city of paths,
+ * @param paths [in]      – array of paths,
+ * @param paths_num [in]  – number of paths, at least 1.
+ * @return Pointer to descriptions of paths in format of
+ * @ref getRouteDescription without route number, separated by new lines,
+ * or NULL if allocation error occurred.
+ */
+static char *describePaths(City *city1, path_t **paths, size_t paths_num) {
+    size_t desc_len = 0, offset = 0;
+    char *buffer;
+
+    for (size_t i = 0; i < paths_num; i++)
+        desc_len += getPathDescriptionLength(city1, paths[i]->roads) + 1;
+    buffer = MEMORY_ALLOC(MEMORY_PATH, sizeof(char) * desc_len);
+    if (buffer == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < paths_num; i++) {
+        fillPathDescription(city1, paths[i]->roads, buffer + offset);
+        offset += getPathDescriptionLength(city1, paths[i]->roads);
+        buffer[offset++] = '\n';
+    }
+    buffer[offset - 1] = '\0';
+    return buffer;
+}
+
+/** @brief Finds cities for query about paths between them.
+ * Used by queries about paths, which don't modify map.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city,
+ * @param cities [out]    – array of found cities,
+ * @param status [out]    – result of query, set unless cities may be
+ *                          connected.
+ * @return Value @p true if cities exist, are different and may be
+ * connected. Otherwise value @p false.
+ */
+static bool findQueryCities(Map *map, const char *city1, const char *city2,
+                            City **cities, path_status_t *status) {
+    *status = PATH_INVALID;
+    if (!checkCityName(city1) || !checkCityName(city2) || map == NULL)
+        return false;
+    if (strcmp(city1, city2) == 0)
+        return false;
+
+    cities[0] = findCity(map, city1);
+    cities[1] = findCity(map, city2);
+    if (cities[0] == NULL || cities[1] == NULL)
+        return false;
+
+    if (!checkIfCitiesMayBeConnected(map, cities[0], cities[1])) {
+        SEARCH_STATS_ADD(component_rejects, 1);
+        *status = PATH_UNREACHABLE;
+        return false;
+    }
+    return true;
+}
+
+/** @brief Finds best path between two cities using only young roads.
+ * Used only by @ref findShortestPath and @ref findShortestPathSince.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city,
+ * @param min_year [in]   – oldest year of road which can be used,
+ * @param status [out]    – result of search.
+ * @return Pointer to description of path or NULL if path wasn't found.
+ */
+static char *findPathDescription(Map *map, const char *city1,
+                                 const char *city2, int min_year,
+                                 path_status_t *status) {
+    City *cities[2];
+    path_t *path;
+    char *buffer = NULL;
+    size_t desc_len;
+
+    if (!findQueryCities(map, city1, city2, cities, status))
+        return NULL;
+
+    path = searchBestPath(map->workspace, map, cities[0], cities[1], NULL,
+                          true, min_year, status);
+    if (path == NULL)
+        return NULL;
+
+    if (!searchIfPathDefinedUnambiguously(map->workspace, map, path, cities[0],
+                                          cities[1], NULL, true, min_year)) {
+        *status = PATH_AMBIGUOUS;
+    } else {
+        desc_len = getPathDescriptionLength(cities[0], path->roads);
+        buffer = MEMORY_ALLOC(MEMORY_PATH, sizeof(char) * (desc_len + 1));
+        if (buffer == NULL) {
+            *status = PATH_ERROR;
+        } else {
+            fillPathDescription(cities[0], path->roads, buffer);
+            buffer[desc_len] = '\0';
+        }
+    }
+
+    deletePath(path);
+    return buffer;
+}
+
+/** @brief Finds best path between two cities without creating route.
+ * Path is selected like in @ref newRoute, but map isn't modified and no
+ * memory is kept after return. Uses search workspace of map, which visits
+ * only cities closer than @p city2.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city,
+ * @param status [out]    – result of search.
+ * @return Pointer to description of path in format of
+ * @ref getRouteDescription without route number, or NULL if path wasn't
+ * found. Description has to be freed by caller.
+ */
+char const *findShortestPath(Map *map, const char *city1, const char *city2,
+                             path_status_t *status) {
+    return findPathDescription(map, city1, city2, INT_MIN, status);
+}
+
+/** @brief Finds best path between two cities using only young roads.
+ * Path is selected like in @ref findShortestPath from roads built or
+ * repaired in @p minYear or later.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city,
+ * @param minYear [in]    – oldest year of road which can be used,
+ * @param status [out]    – result of search.
+ * @return Pointer to description of path in format of
+ * @ref getRouteDescription without route number, or NULL if path wasn't
+ * found. Description has to be freed by caller.
+ */
+char const *findShortestPathSince(Map *map, const char *city1,
+                                  const char *city2, int minYear,
+                                  path_status_t *status) {
+    if (!checkYear(minYear)) {
+        *status = PATH_INVALID;
+        return NULL;
+    }
+    return findPathDescription(map, city1, city2, minYear, status);
+}
+
+/** @brief Finds k shortest loopless paths between two cities.
+ * Paths are compared like in @ref newRoute, path chosen by @ref newRoute
+ * is first if it's defined unambiguously. Map isn't modified.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city,
+ * @param k [in]          – maximal number of paths,
+ * @param status [out]    – result of search.
+ * @return Pointer to descriptions of paths in format of
+ * @ref getRouteDescription without route number, separated by new lines,
+ * or NULL if paths weren't found. Descriptions have to be freed by caller.
+ */
+char const *findAlternativePaths(Map *map, const char *city1,
+                                 const char *city2, unsigned k,
+                                 path_status_t *status) {
+    City *cities[2];
+    path_t **paths;
+    size_t paths_num;
+    char *buffer;
+
+    if (k == 0) {
+        *status = PATH_INVALID;
+        return NULL;
+    }
+    if (!findQueryCities(map, city1, city2, cities, status))
+        return NULL;
+
+    paths = findKShortestPaths(map, cities[0], cities[1], k, &paths_num,
+                               status);
+    if (paths == NULL)
+        return NULL;
+
+    buffer = describePaths(cities[0], paths, paths_num);
+    if (buffer == NULL)
+        *status = PATH_ERROR;
+    deletePaths(paths, paths_num);
+    return buffer;
+}
+
+/** @brief Finds Pareto optimal paths between two cities.
+ * Path is Pareto optimal if every other path is longer or has older oldest
+ * road, unless it has the same length and year. For every such pair of
+ * length and year one path is given. Map isn't modified.
+ * @param map [in,out]    – pointer to map,
+ * @param city1 [in]      – pointer to name of first city,
+ * @param city2 [in]      – pointer to name of second city,
+ * @param status [out]    – result of search.
+ * @return Pointer to descriptions of paths in format of
+ * @ref getRouteDescription without route number, separated by new lines
+ * and sorted by length, or NULL if paths weren't found. Descriptions have
+ * to be freed by caller.
+ */
+char const *findParetoPaths(Map *map, const char *city1, const char *city2,
+                            path_status_t *status) {
+    City *cities[2];
+    path_t **paths;
+    size_t paths_num;
+    char *buffer;
+
+    if (!findQueryCities(map, city1, city2, cities, status))
+        return NULL;
+
+    paths = searchParetoPaths(map->workspace, map, cities[0], cities[1],
+                              &paths_num, status);
+    if (paths == NULL)
+        return NULL;
+
+    buffer = describePaths(cities[0], paths, paths_num);
+    if (buffer == NULL)
+        *status = PATH_ERROR;
+    deletePaths(paths, paths_num);
+    return buffer;
+}
+
+/** @brief Finds cities with given names.
+ * Used only by @ref distanceMatrix.
+ * @param map [in]        – pointer to map,
+ * @param names [in]      – array of names of cities,
+ * @param names_num [in]  – number of names,
+ * @param cities [out]    – array of found cities.
+ * @return Value @p true if all names are correct and all cities exist.
+ * Value @p false otherwise.
+ */
+static bool findCities(Map *map, const char *const *names, size_t names_num,
+                       City **cities) {
+    for (size_t i = 0; i < names_num; i++) {
+        if (!checkCityName(names[i]))
+            return false;
+        cities[i] = findCity(map, names[i]);
+        if (cities[i] == NULL)
+            return false;
+    }
+    return true;
+}
+
+/** @brief Computes shortest paths between every source and every target.
+ * Distance is length of path chosen like in @ref newRoute and year of its
+ * oldest road. Path doesn't have to be defined unambiguously. Map isn't
+ * modified. Every source is searched once, searches are run concurrently.
+ * @param map [in,out]       – pointer to map,
+ * @param sources [in]       – array of names of sources,
+ * @param sources_num [in]   – number of sources,
+ * @param targets [in]       – array of names of targets,
+ * @param targets_num [in]   – number of targets,
+ * @param distances [out]    – matrix of @p sources_num rows and
+ *                             @p targets_num columns.
+ * @return Value @p true if distances were computed. Value @p false if any
+ * name is incorrect, any city doesn't exist or allocation error occurred.
+ */
+bool distanceMatrix(Map *map, const char *const *sources, size_t sources_num,
+                    const char *const *targets, size_t targets_num,
+                    distance_t *distances) {
+    City **cities;
+    bool result = false;
+
+    if (map == NULL || sources_num == 0 || targets_num == 0)
+        return false;
+
+    cities = (City **) MEMORY_ALLOC(MEMORY_MAP, sizeof(City *) *
+                                                (sources_num + targets_num));
+    if (cities == NULL)
+        return false;
+
+    if (findCities(map, sources, sources_num, cities) &&
+        findCities(map, targets, targets_num, cities + sources_num))
+        result = computeDistanceMatrix(map, cities, sources_num,
+                                       cities + sources_num, targets_num,
+                                       distances);
+
+    MEMORY_FREE(MEMORY_MAP, cities);
+    return result;
 }
 
 /** @brief Destroys list with roads and roads' old years.
@@ -653,17 +1638,23 @@ static void destroyRoadDescList(list_t *roads) {
  * for roads not created in @ref createRoute. Assumes that @p roads
  * and @p old_years have same length, @p roads contains Road pointers and
  * @p old_year contains int pointers or NULL. If old year is NULL, corresponding
- * road is treated as new road.
+ * road is treated as new road. Roads not created in @ref createRoute are
+ * moved in index of roads to their years.
+ * @param map [in,out]    - pointer to map,
  * @param roads [in]      - pointer to list of roads,
  * @param old_years [in]  - pointer to list of old years.
  */
-static void destroyRoadList(list_t *roads, list_t *old_years) {
+static void destroyRoadList(Map *map, list_t *roads, list_t *old_years) {
+    Road *road;
+
     while (!emptyList(&roads)) {
         int *old_year = (int *) removeHeadList(&old_years);
         if (old_year == NULL) {
             deleteRoad((Road *) removeHeadList(&roads));
         } else {
-            ((Road *) removeHeadList(&roads))->year = *old_year;
+            road = (Road *) removeHeadList(&roads);
+            road->year = *old_year;
+            reindexRoad(&map->roads_index, road);
         }
     }
     deleteList(&roads);
@@ -773,61 +1764,72 @@ safeInsertOrModify(Map **map, list_t **cities, list_t **roads, list_t **years) {
     return true;
 }
 
+/** @brief Checks if route can be created from roads.
+ * Checks everything, what makes @ref createRoute fail other than allocation
+ * error: names, lengths and years, and lengths and years of roads, which
+ * already exist. Map isn't modified.
+ * @param map [in,out]    - pointer to map,
+ * @param roads [in]      - array of road descriptions,
+ * @param roads_num [in]  - number of road descriptions.
+ * @return Value @p true if route can be created. Otherwise value @p false.
+ */
+static bool checkRouteRoads(Map *map, const road_desc_t *roads,
+                            size_t roads_num) {
+    City *cities[2];
+    Road *road;
+
+    for (size_t i = 0; i < roads_num; i++) {
+        if (!checkCityName(roads[i].city1) || !checkCityName(roads[i].city2) ||
+            !checkLength(roads[i].length) || !checkYear(roads[i].year))
+            return false;
+
+        cities[0] = findCity(map, roads[i].city1);
+        cities[1] = findCity(map, roads[i].city2);
+        if (cities[0] == NULL || cities[1] == NULL)
+            continue;
+        road = getRoadToCity(cities[0], cities[1]);
+        if (road != NULL &&
+            (road->length != roads[i].length || road->year > roads[i].year))
+            return false;
+    }
+    return true;
+}
+
 /** @brief Create new route.
- * Assumes that road descriptions are in reverse order. Road description is
- * in format:
- * city1;length;year;city2
+ * Road descriptions are in order of route. Road description contains names
+ * of connected cities, length and year.
  * If city doesn't exist, creates it. If road doesn't exist, creates it, but
  * if exists: if length are the same, repairs road, if not or new year is smaller
  * rollbacks all previous changes. Function checks if city names, lengths, years
  * are correct, but assumes that correct route is described (roads makes a path).
  * Do nothing if route already exists.
  * Function has strong guarantee. Changes are made only if route can be created.
+ * Roads are checked before any city is created, so names of cities are added
+ * to pool of names only if route is correct.
  * @param map [in,out]    - double pointer to map,
  * @param routeId [in]    - route number,
- * @param roads_list [in] - pointer to road descriptions.
+ * @param roads [in]      - array of road descriptions,
+ * @param roads_num [in]  - number of road descriptions.
  * @return Value @p true if route was created. Otherwise value @p false.
  */
-bool createRoute(Map **map, unsigned routeId, list_t *roads_list) {
+bool createRoute(Map **map, unsigned routeId, const road_desc_t *roads,
+                 size_t roads_num) {
     City *city1 = NULL, *city2, *first_city = NULL, *last_city = NULL;
     Road *road;
     Route *route;
-    list_t *tmp_node;
     list_t *route_roads = newList(), *add_cities = newList();
     list_t *add_roads = newList(), *old_years = newList();
-    size_t roads_list_size = 0;
-    char *road_desc, *city_name1, *city_name2;
+    list_t *tmp_node, *years_node;
+    unsigned new_cities = 0;
+    const char *city_name1, *city_name2, *handle;
     unsigned length;
     int year;
     bool route_created = false;
 
     if (!checkRouteId(routeId) || map == NULL || route_roads == NULL ||
-        add_cities == NULL || add_roads == NULL || old_years == NULL) {
-        deleteList(&route_roads);
-        deleteList(&add_cities);
-        deleteList(&add_roads);
-        deleteList(&old_years);
-        destroyRoadDescList(roads_list);
-        return false;
-    }
-
-    route = (*map)->routes[routeId];
-    if (route != NULL) {
-        deleteList(&route_roads);
-        deleteList(&add_cities);
-        deleteList(&add_roads);
-        deleteList(&old_years);
-        destroyRoadDescList(roads_list);
-        return false;
-    }
-
-    tmp_node = roads_list;
-    while (tmp_node != NULL && tmp_node->value != NULL) {
-        roads_list_size++;
-        tmp_node = tmp_node->next;
-    }
-    if (roads_list_size == 0) {
-        destroyRoadDescList(roads_list);
+        add_cities == NULL || add_roads == NULL || old_years == NULL ||
+        (*map)->routes[routeId] != NULL || roads_num == 0 ||
+        !checkRouteRoads(*map, roads, roads_num)) {
         deleteList(&route_roads);
         deleteList(&add_cities);
         deleteList(&add_roads);
@@ -835,120 +1837,91 @@ bool createRoute(Map **map, unsigned routeId, list_t *roads_list) {
         return false;
     }
 
-    while ((road_desc = (char *) removeHeadList(&roads_list)) != NULL) {
-        city_name1 = strtok(road_desc, ";");
-        length = parseStringToUnsigned(strtok(NULL, ";"));
-        year = parseStringToInt(strtok(NULL, ";"));
-        city_name2 = strtok(NULL, ";");
-
-        char *cities[2];
-        cities[0] = malloc(sizeof(char) * (strlen(city_name1) + 1));
-        cities[1] = malloc(sizeof(char) * (strlen(city_name2) + 1));
+    // Roads are added from the last one.
+    for (size_t i = roads_num; i > 0; i--) {
+        city_name1 = roads[i - 1].city1;
+        city_name2 = roads[i - 1].city2;
+        length = roads[i - 1].length;
+        year = roads[i - 1].year;
 
         if (!checkCityName(city_name1) || !checkCityName(city_name2) ||
-            !checkLength(length) || !checkYear(year) || cities[0] == NULL ||
-            cities[1] == NULL) {
-            free(road_desc);
-            free(cities[0]);
-            free(cities[1]);
+            !checkLength(length) || !checkYear(year)) {
             goto rollback;
         }
         if (last_city == NULL) {
-            city2 = mapGet((*map)->cities, (void *) city_name2);
+            city2 = findCity(*map, city_name2);
         } else {
             city2 = city1;
         }
         if (city2 == NULL) {
             assert(last_city == NULL);
-            strcpy(cities[1], city_name2);
-            city2 = createCity(cities[1]);
-            if (city2 == NULL) {
-                free(road_desc);
-                free(cities[0]);
-                free(cities[1]);
+            handle = namePoolIntern((*map)->names, city_name2);
+            if (handle == NULL)
+                goto rollback;
+            city2 = createCity(handle, (*map)->cities_num + new_cities);
+            if (city2 == NULL)
                 goto rollback;
-            }
             if (last_city == NULL) {
                 if (!addList(&add_cities, (void *) city2)) {
                     deleteCity(city2);
-                    free(road_desc);
-                    free(cities[0]);
                     goto rollback;
                 }
                 last_city = city2;
+                new_cities++;
             }
         } else {
-            free(cities[1]);
             if (last_city == NULL) {
                 last_city = city2;
-                if (!addList(&add_cities, NULL)) {
-                    free(cities[0]);
-                    free(road_desc);
+                if (!addList(&add_cities, NULL))
                     goto rollback;
-                }
             }
         }
 
-        city1 = mapGet((*map)->cities, (void *) city_name1);
+        city1 = findCity(*map, city_name1);
         if (city1 == NULL) {
-            strcpy(cities[0], city_name1);
-            city1 = createCity(cities[0]);
-            if (city1 == NULL) {
-                free(road_desc);
-                free(cities[0]);
+            handle = namePoolIntern((*map)->names, city_name1);
+            if (handle == NULL)
+                goto rollback;
+            city1 = createCity(handle, (*map)->cities_num + new_cities);
+            if (city1 == NULL)
                 goto rollback;
-            }
             if (!addList(&add_cities, (void *) city1)) {
-                free(road_desc);
                 deleteCity(city1);
                 goto rollback;
             }
+            new_cities++;
         } else {
-            free(cities[0]);
-            if (!addList(&add_cities, NULL)) {
-                free(road_desc);
+            if (!addList(&add_cities, NULL))
                 goto rollback;
-            }
         }
         first_city = city1;
 
-        road = mapGet(city1->connected_roads, (void *) city2->name);
+        road = getRoadToCity(city1, city2);
         if (road == NULL) {
             road = createRoad(city1, city2, length, year);
-            if (road == NULL) {
-                free(road_desc);
+            if (road == NULL)
                 goto rollback;
-            }
             if (!addList(&old_years, NULL)) {
-                free(road_desc);
                 deleteRoad(road);
                 goto rollback;
             }
             if (!addList(&add_roads, (void *) road)) {
-                free(road_desc);
                 removeHeadList(&old_years);
                 deleteRoad(road);
                 goto rollback;
             }
         } else {
-            if (road->length != length || road->year > year) {
-                free(road_desc);
+            if (road->length != length || road->year > year)
                 goto rollback;
-            }
-            if (!addList(&old_years, (void *) &road->year)) {
-                free(road_desc);
+            if (!addList(&old_years, (void *) &road->year))
                 goto rollback;
-            }
             road->year = year;
             if (!addList(&add_roads, road)) {
-                free(road_desc);
                 removeHeadList(&old_years);
                 goto rollback;
             }
         }
 
-        free(road_desc);
-
         if (!addList(&route_roads, (void *) road))
             goto rollback;
     }
@@ -969,7 +1942,26 @@ bool createRoute(Map **map, unsigned routeId, list_t *roads_list) {
     }
 
     (*map)->routes[routeId] = route;
-    deleteList(&roads_list);
+    invalidateBridges(*map);
+    tmp_node = route_roads;
+    while (tmp_node != NULL && tmp_node->value != NULL) {
+        road = (Road *) tmp_node->value;
+        joinCitiesInConnectivity(*map, road->city1, road->city2);
+        tmp_node = tmp_node->next;
+    }
+    // New roads have no old year, other roads could be repaired.
+    tmp_node = add_roads;
+    years_node = old_years;
+    while (tmp_node != NULL && tmp_node->value != NULL) {
+        road = (Road *) tmp_node->value;
+        if (years_node->value == NULL) {
+            indexRoad(&(*map)->roads_index, road);
+        } else {
+            reindexRoad(&(*map)->roads_index, road);
+        }
+        tmp_node = tmp_node->next;
+        years_node = years_node->next;
+    }
     deleteList(&add_roads);
     deleteList(&add_cities);
     deleteList(&old_years);
@@ -977,11 +1969,10 @@ bool createRoute(Map **map, unsigned routeId, list_t *roads_list) {
     return true;
 
     rollback:
-    destroyRoadDescList(roads_list);
     destroyCityList(add_cities);
-    destroyRoadList(add_roads, old_years);
+    destroyRoadList(*map, add_roads, old_years);
     if (!route_created)
         deleteList(&route_roads);
 
     return false;
-}
\ No newline at end of file
+}
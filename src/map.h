@@ -11,6 +11,7 @@
 #define __MAP_H__
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "roads_types.h"
 
 Map *newMap(void);
@@ -20,6 +21,9 @@ void deleteMap(Map *map);
 bool addRoad(Map *map, const char *city1, const char *city2,
              unsigned length, int builtYear);
 
+bool addRoads(Map *map, const road_desc_t *roads, size_t roads_num,
+              bool *added);
+
 bool repairRoad(Map *map, const char *city1, const char *city2, int repairYear);
 
 bool newRoute(Map *map, unsigned routeId,
@@ -29,10 +33,40 @@ bool extendRoute(Map *map, unsigned routeId, const char *city);
 
 bool removeRoad(Map *map, const char *city1, const char *city2);
 
+char const *analyzeRemoveRoad(Map *map, const char *city1, const char *city2);
+
 bool removeRoute(Map *map, unsigned routeId);
 
 char const *getRouteDescription(Map *map, unsigned routeId);
 
-bool createRoute(Map **map, unsigned routeId, list_t *roads_list);
+char const *getOldestRoads(Map *map, unsigned k);
+
+bool countRoadsOlderThan(Map *map, int year, size_t *count);
+
+char const *getOldestRouteRoad(Map *map, unsigned routeId);
+
+char const *findShortestPath(Map *map, const char *city1, const char *city2,
+                             path_status_t *status);
+
+char const *findShortestPathSince(Map *map, const char *city1,
+                                  const char *city2, int minYear,
+                                  path_status_t *status);
+
+char const *findAlternativePaths(Map *map, const char *city1,
+                                 const char *city2, unsigned k,
+                                 path_status_t *status);
+
+char const *findParetoPaths(Map *map, const char *city1, const char *city2,
+                            path_status_t *status);
+
+bool distanceMatrix(Map *map, const char *const *sources, size_t sources_num,
+                    const char *const *targets, size_t targets_num,
+                    distance_t *distances);
+
+bool findReachableCities(Map *map, const char *city, unsigned maxLength,
+                         reach_t **reached, size_t *reached_num);
+
+bool createRoute(Map **map, unsigned routeId, const road_desc_t *roads,
+                 size_t roads_num);
 
 #endif /* __MAP_H__ */
@@ -1,6 +1,95 @@
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
 #include "text_interface.h"
 
-int main() {
-    runMapInterface();
-    return 0;
-}
\ No newline at end of file
+/** @brief Prints usage of program.
+ * @param program [in] - name of program.
+ */
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--stats-file FILE] [--stats-interval SECONDS]"
+                    " [--slow-log FILE] [--slow-threshold MICROSECONDS]\n"
+                    "       %s --replay FILE [--repeat N] [--warmup N]"
+                    " [--slow-log FILE] [--slow-threshold MICROSECONDS]\n",
+            program, program);
+}
+
+/** @brief Parses number given as option argument.
+ * @param text [in]    - option argument,
+ * @param min [in]     - minimal allowed number,
+ * @param value [out]  - parsed number.
+ * @return Value @p true if argument is number not less than @p min.
+ * Otherwise value @p false.
+ */
+static bool parseOptionNumber(const char *text, unsigned min,
+                              unsigned *value) {
+    char *end;
+    unsigned long number = strtoul(text, &end, 10);
+
+    if (*text < '0' || *text > '9' || *end != '\0' || number < min ||
+        number > 0xFFFFFFFFul)
+        return false;
+    *value = (unsigned) number;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+            {"stats-file",     required_argument, NULL, 'f'},
+            {"stats-interval", required_argument, NULL, 'i'},
+            {"slow-log",       required_argument, NULL, 'l'},
+            {"slow-threshold", required_argument, NULL, 't'},
+            {"replay",         required_argument, NULL, 'r'},
+            {"repeat",         required_argument, NULL, 'n'},
+            {"warmup",         required_argument, NULL, 'w'},
+            {NULL, 0,                             NULL, 0}
+    };
+    interface_options_t options = {NULL, 10, NULL, 1000, NULL, 1, 0};
+    bool replay_options = false;
+    bool valid = true;
+    int option;
+
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 'f':
+                options.stats_file = optarg;
+                break;
+            case 'i':
+                valid = parseOptionNumber(optarg, 1, &options.stats_interval);
+                break;
+            case 'l':
+                options.slow_log = optarg;
+                break;
+            case 't':
+                valid = parseOptionNumber(optarg, 1, &options.slow_threshold);
+                break;
+            case 'r':
+                options.replay = optarg;
+                break;
+            case 'n':
+                valid = parseOptionNumber(optarg, 1, &options.repeat);
+                replay_options = true;
+                break;
+            case 'w':
+                valid = parseOptionNumber(optarg, 0, &options.warmup);
+                replay_options = true;
+                break;
+            default:
+                valid = false;
+                break;
+        }
+        if (!valid)
+            break;
+    }
+    // Repeat and warm-up need replay, which prints statistics itself.
+    if (options.replay == NULL ? replay_options : options.stats_file != NULL)
+        valid = false;
+    if (!valid || optind != argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    return runMapInterface(&options);
+}
@@ -0,0 +1,174 @@
+/** @file
+ * Implementation of memory accounting.
+ * Sizes of blocks are taken from allocator (usable size), so the same size
+ * is counted when block is allocated and freed, and counters include
+ * rounding done by allocator. Counters are atomic, because parser thread
+ * allocates concurrently with executor.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <malloc.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "memory_stats.h"
+
+#ifdef ROADS_MEMORY_STATS
+/**
+ * Names of subsystems.
+ */
+static const char *memory_tag_names[MEMORY_TAGS_NUM] = {
+        "city", "road", "route", "list", "avl", "heap", "path", "names", "map",
+        "parser"
+};
+#endif
+
+/**
+ * Number of live bytes of every subsystem.
+ */
+static atomic_uint_fast64_t memory_bytes[MEMORY_TAGS_NUM];
+
+/**
+ * Number of live blocks of every subsystem.
+ */
+static atomic_uint_fast64_t memory_blocks[MEMORY_TAGS_NUM];
+
+/**
+ * Number of all allocations of every subsystem.
+ */
+static atomic_uint_fast64_t memory_allocations[MEMORY_TAGS_NUM];
+
+/** @brief Counts allocated block.
+ * @param tag [in]         - subsystem,
+ * @param ptr [in]         - pointer to block or NULL.
+ */
+static void countAllocation(memory_tag_t tag, void *ptr) {
+    if (ptr == NULL)
+        return;
+    atomic_fetch_add_explicit(&memory_bytes[tag], malloc_usable_size(ptr),
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&memory_blocks[tag], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&memory_allocations[tag], 1,
+                              memory_order_relaxed);
+}
+
+/** @brief Counts block which will be freed.
+ * @param tag [in]         - subsystem,
+ * @param ptr [in]         - pointer to block or NULL.
+ */
+static void countFree(memory_tag_t tag, void *ptr) {
+    if (ptr == NULL)
+        return;
+    atomic_fetch_sub_explicit(&memory_bytes[tag], malloc_usable_size(ptr),
+                              memory_order_relaxed);
+    atomic_fetch_sub_explicit(&memory_blocks[tag], 1, memory_order_relaxed);
+}
+
+/** @brief Allocates memory owned by subsystem.
+ * @param tag [in]         - subsystem,
+ * @param size [in]        - size in bytes.
+ * @return Pointer to memory or NULL if allocation error occurred.
+ */
+void *allocMemory(memory_tag_t tag, size_t size) {
+    void *ptr = malloc(size);
+
+    countAllocation(tag, ptr);
+    return ptr;
+}
+
+/** @brief Allocates zeroed memory owned by subsystem.
+ * @param tag [in]         - subsystem,
+ * @param num [in]         - number of elements,
+ * @param size [in]        - size of element in bytes.
+ * @return Pointer to memory or NULL if allocation error occurred.
+ */
+void *callocMemory(memory_tag_t tag, size_t num, size_t size) {
+    void *ptr = calloc(num, size);
+
+    countAllocation(tag, ptr);
+    return ptr;
+}
+
+/** @brief Changes size of memory owned by subsystem.
+ * Memory isn't changed if allocation error occurred.
+ * @param tag [in]         - subsystem,
+ * @param ptr [in]         - pointer to memory or NULL,
+ * @param size [in]        - new size in bytes.
+ * @return Pointer to memory or NULL if allocation error occurred.
+ */
+void *reallocMemory(memory_tag_t tag, void *ptr, size_t size) {
+    size_t old_size = ptr == NULL ? 0 : malloc_usable_size(ptr);
+    void *new_ptr = realloc(ptr, size);
+
+    if (new_ptr == NULL)
+        return NULL;
+    if (ptr == NULL) {
+        countAllocation(tag, new_ptr);
+    } else {
+        atomic_fetch_sub_explicit(&memory_bytes[tag], old_size,
+                                  memory_order_relaxed);
+        atomic_fetch_add_explicit(&memory_bytes[tag],
+                                  malloc_usable_size(new_ptr),
+                                  memory_order_relaxed);
+    }
+    return new_ptr;
+}
+
+/** @brief Frees memory owned by subsystem.
+ * @param tag [in]         - subsystem,
+ * @param ptr [in]         - pointer to memory or NULL.
+ */
+void freeMemory(memory_tag_t tag, void *ptr) {
+    countFree(tag, ptr);
+    free(ptr);
+}
+
+/** @brief Reads memory used by subsystem.
+ * @param tag [in]         - subsystem,
+ * @param usage [out]      - pointer to usage.
+ */
+void getMemoryUsage(memory_tag_t tag, memory_usage_t *usage) {
+    usage->bytes = atomic_load_explicit(&memory_bytes[tag],
+                                        memory_order_relaxed);
+    usage->blocks = atomic_load_explicit(&memory_blocks[tag],
+                                         memory_order_relaxed);
+    usage->allocations = atomic_load_explicit(&memory_allocations[tag],
+                                              memory_order_relaxed);
+}
+
+/** @brief Reports memory used by every subsystem.
+ * Reports one line for every subsystem and line with sum. Reports nothing if
+ * accounting isn't compiled in.
+ * @param report [in]      - function called with every line,
+ * @param data [in,out]    - data passed to @p report.
+ */
+void reportMemoryStats(void (*report)(const char *, void *), void *data) {
+#ifdef ROADS_MEMORY_STATS
+    memory_usage_t usage, total = {0, 0, 0};
+    char line[160];
+
+    for (int i = 0; i < MEMORY_TAGS_NUM; i++) {
+        getMemoryUsage((memory_tag_t) i, &usage);
+        total.bytes += usage.bytes;
+        total.blocks += usage.blocks;
+        total.allocations += usage.allocations;
+        snprintf(line, sizeof(line), "memory %s bytes=%llu blocks=%llu "
+                                     "allocations=%llu", memory_tag_names[i],
+                 (unsigned long long) usage.bytes,
+                 (unsigned long long) usage.blocks,
+                 (unsigned long long) usage.allocations);
+        report(line, data);
+    }
+    snprintf(line, sizeof(line), "memory all bytes=%llu blocks=%llu "
+                                 "allocations=%llu",
+             (unsigned long long) total.bytes,
+             (unsigned long long) total.blocks,
+             (unsigned long long) total.allocations);
+    report(line, data);
+#else
+    (void) report;
+    (void) data;
+#endif
+}
@@ -0,0 +1,81 @@
+/** @file
+ * Interface of memory accounting.
+ * Allocations of engine and parser are tagged by subsystem. Every subsystem
+ * has counters of live bytes and live blocks. Accounting is compiled in only
+ * if macro ROADS_MEMORY_STATS is defined, otherwise allocation macros call
+ * standard functions directly.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_MEMORY_STATS_H
+#define ROADS_MEMORY_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Subsystem owning allocation.
+ */
+typedef enum memory_tag {
+    MEMORY_CITY,                /**< Cities and their arrays of roads. */
+    MEMORY_ROAD,                /**< Roads. */
+    MEMORY_ROUTE,               /**< Routes and their descriptions. */
+    MEMORY_LIST,                /**< Nodes of lists. */
+    MEMORY_AVL,                 /**< Nodes of AVL maps. */
+    MEMORY_HEAP,                /**< Heaps of path search. */
+    MEMORY_PATH,                /**< Found paths and search workspaces. */
+    MEMORY_NAMES,               /**< Pool of city names. */
+    MEMORY_MAP,                 /**< Map structure and temporary arrays. */
+    MEMORY_PARSER,              /**< Buffers of reading and parsing input. */
+    MEMORY_TAGS_NUM             /**< Number of subsystems. */
+} memory_tag_t;
+
+/**
+ * Structure representing memory used by subsystem.
+ */
+typedef struct memory_usage {
+    uint64_t bytes;             /**< Number of live bytes. */
+    uint64_t blocks;            /**< Number of live blocks. */
+    uint64_t allocations;       /**< Number of all allocations. */
+} memory_usage_t;
+
+#ifdef ROADS_MEMORY_STATS
+/**
+ * Macro allocating memory owned by subsystem.
+ */
+#define MEMORY_ALLOC(tag, size) allocMemory(tag, size)
+/**
+ * Macro allocating zeroed memory owned by subsystem.
+ */
+#define MEMORY_CALLOC(tag, num, size) callocMemory(tag, num, size)
+/**
+ * Macro changing size of memory owned by subsystem.
+ */
+#define MEMORY_REALLOC(tag, ptr, size) reallocMemory(tag, ptr, size)
+/**
+ * Macro freeing memory owned by subsystem.
+ */
+#define MEMORY_FREE(tag, ptr) freeMemory(tag, ptr)
+#else
+#define MEMORY_ALLOC(tag, size) malloc(size)
+#define MEMORY_CALLOC(tag, num, size) calloc(num, size)
+#define MEMORY_REALLOC(tag, ptr, size) realloc(ptr, size)
+#define MEMORY_FREE(tag, ptr) free(ptr)
+#endif
+
+void *allocMemory(memory_tag_t tag, size_t size);
+
+void *callocMemory(memory_tag_t tag, size_t num, size_t size);
+
+void *reallocMemory(memory_tag_t tag, void *ptr, size_t size);
+
+void freeMemory(memory_tag_t tag, void *ptr);
+
+void getMemoryUsage(memory_tag_t tag, memory_usage_t *usage);
+
+void reportMemoryStats(void (*report)(const char *, void *), void *data);
+
+#endif //ROADS_MEMORY_STATS_H
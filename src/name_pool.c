@@ -0,0 +1,192 @@
+/** @file
+ * Implementation of pool of interned city names.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "name_pool.h"
+#include "memory_stats.h"
+
+/**
+ * Macro defining default size of arena block.
+ */
+#define NAME_CHUNK_SIZE 65536
+/**
+ * Macro defining initial size of hash table.
+ */
+#define NAME_TABLE_SIZE 64
+
+/** @brief Computes FNV-1a hash of name.
+ * @param name [in]      - name,
+ * @param len [out]      - length of name.
+ * @return Hash of name.
+ */
+static size_t hashName(const char *name, size_t *len) {
+    size_t hash = 14695981039346656037ULL;
+    const char *curr = name;
+
+    while (*curr != '\0') {
+        hash ^= (unsigned char) *curr;
+        hash *= 1099511628211ULL;
+        curr++;
+    }
+    *len = (size_t) (curr - name);
+    return hash;
+}
+
+/** @brief Finds entry with given name or empty entry where it should be.
+ * @param table [in]     - hash table,
+ * @param capacity [in]  - size of hash table,
+ * @param name [in]      - name,
+ * @param hash [in]      - hash of name.
+ * @return Pointer to found entry.
+ */
+static name_entry_t *findEntry(name_entry_t *table, size_t capacity,
+                               const char *name, size_t hash) {
+    size_t pos = hash & (capacity - 1);
+
+    while (table[pos].name != NULL) {
+        if (table[pos].hash == hash && strcmp(table[pos].name, name) == 0)
+            break;
+        pos = (pos + 1) & (capacity - 1);
+    }
+    return &table[pos];
+}
+
+/** @brief Doubles size of hash table.
+ * @param pool [in,out]  - pointer to pool.
+ * @return Value @p true if table was enlarged. Otherwise value @p false.
+ */
+static bool growTable(name_pool_t *pool) {
+    size_t new_capacity = 2 * pool->capacity;
+    name_entry_t *new_table = (name_entry_t *) MEMORY_CALLOC(
+            MEMORY_NAMES, new_capacity, sizeof(name_entry_t));
+
+    if (new_table == NULL)
+        return false;
+
+    for (size_t i = 0; i < pool->capacity; i++) {
+        if (pool->table[i].name != NULL)
+            *findEntry(new_table, new_capacity, pool->table[i].name,
+                       pool->table[i].hash) = pool->table[i];
+    }
+    MEMORY_FREE(MEMORY_NAMES, pool->table);
+    pool->table = new_table;
+    pool->capacity = new_capacity;
+    return true;
+}
+
+/** @brief Copies name to arena.
+ * Allocates new block if current one is too small.
+ * @param pool [in,out]  - pointer to pool,
+ * @param name [in]      - name,
+ * @param len [in]       - length of name.
+ * @return Pointer to copy of name or NULL if allocation error occurred.
+ */
+static const char *storeName(name_pool_t *pool, const char *name, size_t len) {
+    name_chunk_t *chunk = pool->chunks;
+    char *copy;
+
+    if (chunk == NULL || chunk->size - chunk->used < len + 1) {
+        size_t size = len + 1 > NAME_CHUNK_SIZE ? len + 1 : NAME_CHUNK_SIZE;
+        chunk = (name_chunk_t *) MEMORY_ALLOC(MEMORY_NAMES,
+                                              sizeof(name_chunk_t) + size);
+        if (chunk == NULL)
+            return NULL;
+        chunk->size = size;
+        chunk->used = 0;
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+    }
+
+    copy = chunk->data + chunk->used;
+    memcpy(copy, name, len + 1);
+    chunk->used += len + 1;
+    return copy;
+}
+
+/** @brief Creates empty pool.
+ * @return Pointer to new pool or NULL if allocation error occurred.
+ */
+name_pool_t *namePoolInit(void) {
+    name_pool_t *pool = (name_pool_t *) MEMORY_ALLOC(MEMORY_NAMES,
+                                                     sizeof(name_pool_t));
+
+    if (pool == NULL)
+        return NULL;
+
+    pool->table = (name_entry_t *) MEMORY_CALLOC(MEMORY_NAMES, NAME_TABLE_SIZE,
+                                                 sizeof(name_entry_t));
+    if (pool->table == NULL) {
+        MEMORY_FREE(MEMORY_NAMES, pool);
+        return NULL;
+    }
+
+    pool->chunks = NULL;
+    pool->capacity = NAME_TABLE_SIZE;
+    pool->size = 0;
+    return pool;
+}
+
+/** @brief Deletes pool and all names stored in it.
+ * All handles returned by pool become invalid.
+ * @param pool [in]      - pointer to pool.
+ */
+void namePoolDelete(name_pool_t *pool) {
+    name_chunk_t *chunk, *next;
+
+    if (pool == NULL)
+        return;
+
+    chunk = pool->chunks;
+    while (chunk != NULL) {
+        next = chunk->next;
+        MEMORY_FREE(MEMORY_NAMES, chunk);
+        chunk = next;
+    }
+    MEMORY_FREE(MEMORY_NAMES, pool->table);
+    MEMORY_FREE(MEMORY_NAMES, pool);
+}
+
+/** @brief Interns name.
+ * Copies name to pool if it isn't already stored there.
+ * @param pool [in,out]  - pointer to pool,
+ * @param name [in]      - name.
+ * @return Handle of name or NULL if allocation error occurred.
+ */
+const char *namePoolIntern(name_pool_t *pool, const char *name) {
+    size_t len;
+    size_t hash = hashName(name, &len);
+    name_entry_t *entry;
+
+    // Keeping load factor below 1/2.
+    if (2 * (pool->size + 1) > pool->capacity && !growTable(pool))
+        return NULL;
+
+    entry = findEntry(pool->table, pool->capacity, name, hash);
+    if (entry->name != NULL)
+        return entry->name;
+
+    entry->name = storeName(pool, name, len);
+    if (entry->name == NULL)
+        return NULL;
+    entry->hash = hash;
+    pool->size++;
+    return entry->name;
+}
+
+/** @brief Finds handle of name.
+ * @param pool [in,out]  - pointer to pool,
+ * @param name [in]      - name.
+ * @return Handle of name or NULL if name wasn't interned.
+ */
+const char *namePoolFind(name_pool_t *pool, const char *name) {
+    size_t len;
+    size_t hash = hashName(name, &len);
+
+    return findEntry(pool->table, pool->capacity, name, hash)->name;
+}
@@ -0,0 +1,55 @@
+/** @file
+ * Interface of pool of interned city names.
+ * Every name stored in pool exists exactly once and lives in append-only
+ * arena until pool is deleted. Pointer returned by pool (handle) identifies
+ * name, so two names are equal only if their handles are equal.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_NAME_POOL_H
+#define ROADS_NAME_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Structure representing single block of arena. Names are stored one after
+ * another, each terminated by '\0'.
+ */
+typedef struct name_chunk {
+    struct name_chunk *next; /**< pointer to previously filled block */
+    size_t used;             /**< number of used bytes */
+    size_t size;             /**< size of block */
+    char data[];             /**< stored names */
+} name_chunk_t;
+
+/**
+ * Structure representing hash table entry. Empty entry has NULL name.
+ */
+typedef struct name_entry {
+    const char *name;        /**< handle of interned name */
+    size_t hash;             /**< hash of name */
+} name_entry_t;
+
+/**
+ * Structure representing pool of names. Contains arena storing names and
+ * open addressing hash table of handles.
+ */
+typedef struct name_pool {
+    name_chunk_t *chunks;    /**< pointer to block currently being filled */
+    name_entry_t *table;     /**< hash table of handles */
+    size_t capacity;         /**< size of hash table, power of 2 */
+    size_t size;             /**< number of interned names */
+} name_pool_t;
+
+name_pool_t *namePoolInit(void);
+
+void namePoolDelete(name_pool_t *pool);
+
+const char *namePoolIntern(name_pool_t *pool, const char *name);
+
+const char *namePoolFind(name_pool_t *pool, const char *name);
+
+#endif //ROADS_NAME_POOL_H
@@ -0,0 +1,156 @@
+/** @file
+ * Implementation of buffered output of text interface.
+ * If standard output and standard error output refer to the same file,
+ * both streams use one buffer, so relative order of lines is preserved.
+ * Output to terminal is written immediately.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "output.h"
+
+/**
+ * Macro defining size of output buffer.
+ */
+#define OUTPUT_BUFFER_SIZE 65536
+
+/**
+ * Structure representing buffered output file.
+ */
+typedef struct output_buffer {
+    int fd;                         /**< File descriptor. */
+    bool immediate;                 /**< Flag indicating if buffer is flushed
+                                         after every write. */
+    size_t len;                     /**< Number of buffered bytes. */
+    char data[OUTPUT_BUFFER_SIZE];  /**< Buffered bytes. */
+} output_buffer_t;
+
+/**
+ * Buffers of standard output and standard error output.
+ */
+static output_buffer_t buffers[2] = {{STDOUT_FILENO, false, 0, {0}},
+                                     {STDERR_FILENO, false, 0, {0}}};
+
+/**
+ * Buffers used by streams, indexed by @ref output_stream_t.
+ */
+static output_buffer_t *streams[2] = {&buffers[0], &buffers[1]};
+
+/**
+ * Flag indicating if written text is discarded.
+ */
+static bool discarded = false;
+
+/** @brief Writes whole text to file.
+ * Text is lost if write error occurs.
+ * @param fd [in]          - file descriptor,
+ * @param text [in]        - pointer to text,
+ * @param len [in]         - length of text.
+ */
+static void writeAll(int fd, const char *text, size_t len) {
+    ssize_t written;
+
+    while (len > 0) {
+        written = write(fd, text, len);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        text += written;
+        len -= (size_t) written;
+    }
+}
+
+/** @brief Writes buffered bytes to file.
+ * @param buffer [in,out]  - pointer to buffer.
+ */
+static void flushBuffer(output_buffer_t *buffer) {
+    writeAll(buffer->fd, buffer->data, buffer->len);
+    buffer->len = 0;
+}
+
+/** @brief Initiates output.
+ * Checks if streams refer to the same file or to terminal.
+ */
+void initOutput() {
+    struct stat result_stat, error_stat;
+
+    for (int i = 0; i < 2; i++)
+        buffers[i].immediate = isatty(buffers[i].fd) != 0;
+
+    if (fstat(buffers[OUTPUT_RESULT].fd, &result_stat) == 0 &&
+        fstat(buffers[OUTPUT_ERROR].fd, &error_stat) == 0 &&
+        result_stat.st_dev == error_stat.st_dev &&
+        result_stat.st_ino == error_stat.st_ino)
+        streams[OUTPUT_ERROR] = streams[OUTPUT_RESULT];
+}
+
+/** @brief Writes text to stream.
+ * Text is buffered and written when buffer is full.
+ * @param stream [in]      - output stream,
+ * @param text [in]        - pointer to text,
+ * @param len [in]         - length of text.
+ */
+void writeOutput(output_stream_t stream, const char *text, size_t len) {
+    output_buffer_t *buffer = streams[stream];
+
+    if (discarded)
+        return;
+    if (buffer->len + len > OUTPUT_BUFFER_SIZE) {
+        flushBuffer(buffer);
+        if (len > OUTPUT_BUFFER_SIZE) {
+            writeAll(buffer->fd, text, len);
+            return;
+        }
+    }
+
+    memcpy(buffer->data + buffer->len, text, len);
+    buffer->len += len;
+}
+
+/** @brief Writes line with result to standard output.
+ * @param text [in]        - pointer to text without '\n'.
+ */
+void outputLine(const char *text) {
+    writeOutput(OUTPUT_RESULT, text, strlen(text));
+    writeOutput(OUTPUT_RESULT, "\n", 1);
+    if (streams[OUTPUT_RESULT]->immediate)
+        flushBuffer(streams[OUTPUT_RESULT]);
+}
+
+/** @brief Writes error of line with given number to standard error output.
+ * @param line_number [in] - number of line.
+ */
+void outputError(int line_number) {
+    char text[32];
+    int len = snprintf(text, sizeof(text), "ERROR %d\n", line_number);
+
+    writeOutput(OUTPUT_ERROR, text, (size_t) len);
+    if (streams[OUTPUT_ERROR]->immediate)
+        flushBuffer(streams[OUTPUT_ERROR]);
+}
+
+/** @brief Turns discarding of written text on or off.
+ * Used when commands are replayed, so only execution is measured.
+ * @param discard [in]     - flag indicating if text should be discarded.
+ */
+void discardOutput(bool discard) {
+    discarded = discard;
+}
+
+/** @brief Writes all buffered text.
+ */
+void flushOutput() {
+    flushBuffer(streams[OUTPUT_RESULT]);
+    if (streams[OUTPUT_ERROR] != streams[OUTPUT_RESULT])
+        flushBuffer(streams[OUTPUT_ERROR]);
+}
@@ -0,0 +1,35 @@
+/** @file
+ * Interface of buffered output of text interface.
+ * Results and errors are collected in buffers and written in large blocks.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_OUTPUT_H
+#define ROADS_OUTPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Output stream.
+ */
+typedef enum output_stream {
+    OUTPUT_RESULT,              /**< Standard output. */
+    OUTPUT_ERROR                /**< Standard error output. */
+} output_stream_t;
+
+void initOutput();
+
+void writeOutput(output_stream_t stream, const char *text, size_t len);
+
+void outputLine(const char *text);
+
+void outputError(int line_number);
+
+void discardOutput(bool discard);
+
+void flushOutput();
+
+#endif //ROADS_OUTPUT_H
@@ -0,0 +1,144 @@
+/** @file
+ * Implementation of module running independent searches on map in parallel.
+ * Items are taken by threads one by one, every thread has its own search
+ * workspace, so searches don't share any written memory. Map isn't modified
+ * while threads run. Current thread processes items too, so all items are
+ * processed even if no thread can be created.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "parallel_search.h"
+#include "memory_stats.h"
+#include "search.h"
+#include "search_stats.h"
+
+/**
+ * Maximal number of threads processing items of one call.
+ */
+#define PARALLEL_SEARCH_MAX_THREADS 16
+
+/**
+ * Structure describing items processed by threads.
+ */
+typedef struct search_task {
+    Map *map;                   /**< Pointer to map. */
+    search_item_fn_t process;   /**< Function processing one item. */
+    void *data;                 /**< Data given to function. */
+    size_t items_num;           /**< Number of items. */
+    atomic_size_t next_item;    /**< Number of next item to process. */
+    atomic_bool failed;         /**< Flag indicating that allocation error
+                                     occurred. */
+} search_task_t;
+
+/**
+ * Structure describing thread processing items.
+ */
+typedef struct search_worker {
+    search_task_t *task;        /**< Pointer to processed items. */
+    search_workspace_t *workspace; /**< Workspace of searches, NULL if thread
+                                        creates its own. */
+    pthread_t thread;           /**< Thread. */
+    search_stats_t stats;       /**< Statistics of searches of thread. */
+} search_worker_t;
+
+/** @brief Processes items until all of them are taken.
+ * @param data [in,out]    - pointer to worker.
+ * @return NULL.
+ */
+static void *processItems(void *data) {
+    search_worker_t *worker = (search_worker_t *) data;
+    search_task_t *task = worker->task;
+    search_workspace_t *workspace = worker->workspace != NULL
+                                    ? worker->workspace
+                                    : createSearchWorkspace();
+    size_t item;
+
+    if (workspace == NULL) {
+        atomic_store(&task->failed, true);
+        return NULL;
+    }
+
+    while (!atomic_load_explicit(&task->failed, memory_order_relaxed) &&
+           (item = atomic_fetch_add(&task->next_item, 1)) < task->items_num) {
+        if (!task->process(workspace, task->map, task->data, item))
+            atomic_store(&task->failed, true);
+    }
+
+    if (workspace != worker->workspace)
+        deleteSearchWorkspace(workspace);
+#ifdef ROADS_SEARCH_STATS
+    worker->stats = search_stats;
+#endif
+    return NULL;
+}
+
+/** @brief Returns number of threads processing items.
+ * @param items_num [in]   - number of items.
+ * @return Number of threads, at least 1.
+ */
+static size_t getThreadsNumber(size_t items_num) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = cpus < 1 ? 1 : (size_t) cpus;
+
+    if (threads > PARALLEL_SEARCH_MAX_THREADS)
+        threads = PARALLEL_SEARCH_MAX_THREADS;
+    if (threads > items_num)
+        threads = items_num;
+    return threads == 0 ? 1 : threads;
+}
+
+/** @brief Processes items concurrently.
+ * Current thread uses search workspace of map, other threads create their
+ * own. Statistics of searches of all threads are added to statistics of
+ * current thread. Stops taking items after first failure.
+ * @param map [in,out]     - pointer to map,
+ * @param items_num [in]   - number of items,
+ * @param process [in]     - function processing one item,
+ * @param data [in,out]    - data given to function.
+ * @return Value @p true if all items were processed. Value @p false if
+ * allocation error occurred.
+ */
+bool runParallelSearches(Map *map, size_t items_num, search_item_fn_t process,
+                         void *data) {
+    search_task_t task;
+    search_worker_t *workers;
+    size_t threads_num = getThreadsNumber(items_num), started = 1;
+
+    task.map = map;
+    task.process = process;
+    task.data = data;
+    task.items_num = items_num;
+    atomic_init(&task.next_item, 0);
+    atomic_init(&task.failed, false);
+
+    workers = (search_worker_t *) MEMORY_CALLOC(MEMORY_MAP, threads_num,
+                                                sizeof(search_worker_t));
+    if (workers == NULL)
+        return false;
+
+    for (size_t i = 0; i < threads_num; i++)
+        workers[i].task = &task;
+    // Worker 0 is current thread, it uses workspace of map.
+    workers[0].workspace = map->workspace;
+    while (started < threads_num &&
+           pthread_create(&workers[started].thread, NULL, processItems,
+                          &workers[started]) == 0)
+        started++;
+    processItems(&workers[0]);
+    for (size_t i = 1; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+#ifdef ROADS_SEARCH_STATS
+        addSearchStats(&search_stats, &workers[i].stats);
+#endif
+    }
+
+    MEMORY_FREE(MEMORY_MAP, workers);
+    return !atomic_load(&task.failed);
+}
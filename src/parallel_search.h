@@ -0,0 +1,27 @@
+/** @file
+ * Interface of module running independent searches on map in parallel.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_PARALLEL_SEARCH_H
+#define ROADS_PARALLEL_SEARCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "roads_types.h"
+
+/**
+ * Type of function processing one item. Gets workspace of thread, map, data
+ * given by caller and number of item. Returns @p false if allocation error
+ * occurred.
+ */
+typedef bool (*search_item_fn_t)(search_workspace_t *workspace, Map *map,
+                                  void *data, size_t item);
+
+bool runParallelSearches(Map *map, size_t items_num, search_item_fn_t process,
+                         void *data);
+
+#endif //ROADS_PARALLEL_SEARCH_H
@@ -9,11 +9,13 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <string.h>
 
+#include "city.h"
 #include "heap.h"
+#include "memory_stats.h"
 #include "road.h"
 #include "path.h"
+#include "search_stats.h"
 
 /** @brief Makes cities invisible for Dijkstra algorithm.
  * Sets num_in_heap field to 0 for every city that is end of any road from list,
@@ -51,6 +53,30 @@ bool checkIfFirstPathBetter(path_t *path1, path_t *path2) {
     return path1->year > path2->year;
 }
 
+/** @brief Deletes path.
+ * Does nothing if pointer is NULL.
+ * @param path [in]          - pointer to path.
+ */
+void deletePath(path_t *path) {
+    if (path == NULL)
+        return;
+    deleteList(&path->roads);
+    MEMORY_FREE(MEMORY_PATH, path);
+}
+
+/** @brief Deletes array of paths.
+ * Does nothing if array is NULL.
+ * @param paths [in]         - array of paths,
+ * @param paths_num [in]     - number of paths.
+ */
+void deletePaths(path_t **paths, size_t paths_num) {
+    if (paths == NULL)
+        return;
+    for (size_t i = 0; i < paths_num; i++)
+        deletePath(paths[i]);
+    MEMORY_FREE(MEMORY_PATH, paths);
+}
+
 /** @brief Checks if path was selected unambiguously.
  * Assumes that @p map, @p city1, @p city2, @p exclude_roads, @p direct are
  * the same as in @ref findBestPath function which returned @p path.
@@ -74,19 +100,22 @@ bool checkIfPathDefinedUnambiguously(Map *map, path_t *path, City *city1,
     City *curr_city;
     heap_t *heap;
     heap_node_t *heap_node;
-    list_t *cities, *roads;
+    list_t *cities;
     list_t *tmp_node;
 
     unsigned new_len;
     int new_year;
 
     cities = mapGetValuesList(map->cities);
-    if (cities == NULL)
+    if (cities == NULL) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
         return false;
+    }
 
     heap = createHeap(map->cities_num);
     if (heap == NULL) {
         deleteList(&cities);
+        SEARCH_STATS_END(SEARCH_END_ERROR);
         return false;
     }
 
@@ -98,23 +127,27 @@ bool checkIfPathDefinedUnambiguously(Map *map, path_t *path, City *city1,
 
     fillHeapWithCitiesFromList(heap, &cities);
     deleteList(&cities);
+    SEARCH_STATS_ADD(heap_init, heap->size);
+    SEARCH_STATS_ADD(pushes, heap->size);
     if (exclude_roads != NULL)
         excludeCitiesFromRoadLists(exclude_roads, city1, city2);
     decreaseHeapKey(heap, city1->num_in_heap, 0, INT_MAX);
     heap_node = popHeap(heap);
+    SEARCH_STATS_ADD(pops, 1);
     new_len = 0;
     new_year = INT_MAX;
     assert(heap_node != NULL);
 
     curr_city = city1;
     tmp_node = path->roads;
-    while (strcmp(curr_city->name, city2->name) != 0) {
+    while (curr_city != city2) {
         Road *curr_road = (Road *) tmp_node->value;
         City *next_city = getNextCity(curr_city, curr_road);
         new_len += curr_road->length;
         new_year = new_year < curr_road->year ? new_year : curr_road->year;
 
         decreaseHeapKey(heap, next_city->num_in_heap, new_len, new_year);
+        SEARCH_STATS_ADD(decreased, 1);
         next_city->prev_city = curr_city;
 
         curr_city = next_city;
@@ -122,22 +155,17 @@ bool checkIfPathDefinedUnambiguously(Map *map, path_t *path, City *city1,
     }
 
     curr_city = city1;
-    while (strcmp(curr_city->name, city2->name) != 0) {
+    while (curr_city != city2) {
         if ((heap_node->total_len == UINT_MAX && heap_node->year == INT_MAX) ||
             curr_city->num_in_heap == 0) {
             deleteHeap(heap);
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
             return false;
         }
-        roads = mapGetValuesList(curr_city->connected_roads);
-        if (roads == NULL) {
-            deleteHeap(heap);
-            return false;
-        }
-        assert(roads != NULL);
-
-        tmp_node = roads;
-        while (tmp_node->value != NULL) {
-            Road *curr_road = (Road *) tmp_node->value;
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
             City *next_city = getNextCity(curr_city, curr_road);
             new_len = heap_node->total_len + curr_road->length;
             new_year = heap_node->year < curr_road->year ? heap_node->year
@@ -148,28 +176,29 @@ bool checkIfPathDefinedUnambiguously(Map *map, path_t *path, City *city1,
                 if (next_city->num_in_heap != 0) {
                     if (decreaseHeapKey(heap, next_city->num_in_heap, new_len,
                                         new_year)) {
+                        SEARCH_STATS_ADD(decreased, 1);
                         if (next_city->prev_city != NULL &&
                             next_city->prev_city != curr_city) {
-                            deleteList(&roads);
                             deleteHeap(heap);
+                            SEARCH_STATS_END(SEARCH_END_AMBIGUOUS);
                             return false;
                         }
                     }
                 }
             }
-
-            tmp_node = tmp_node->next;
         }
-        deleteList(&roads);
         heap_node = popHeap(heap);
+        SEARCH_STATS_ADD(pops, 1);
         if (heap_node == NULL) {
             deleteHeap(heap);
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
             return false;
         }
         assert(heap_node != NULL);
         curr_city = heap_node->city;
     }
     deleteHeap(heap);
+    SEARCH_STATS_END(SEARCH_END_TARGET);
     return true;
 }
 
@@ -191,9 +220,8 @@ path_t *findBestPath(Map *map, City *city1, City *city2, list_t **exclude_roads,
     City *curr_city;
     heap_t *heap;
     heap_node_t *heap_node;
-    list_t *cities, *roads;
-    list_t *tmp_node;
-    path_t *path = (path_t *) malloc(sizeof(path_t));
+    list_t *cities;
+    path_t *path = (path_t *) MEMORY_ALLOC(MEMORY_PATH, sizeof(path_t));
 
     unsigned new_len;
     int new_year;
@@ -203,44 +231,43 @@ path_t *findBestPath(Map *map, City *city1, City *city2, list_t **exclude_roads,
 
     cities = mapGetValuesList(map->cities);
     if (cities == NULL) {
-        free(path);
+        MEMORY_FREE(MEMORY_PATH, path);
+        SEARCH_STATS_END(SEARCH_END_ERROR);
         return NULL;
     }
 
     heap = createHeap(map->cities_num);
     if (heap == NULL) {
         deleteList(&cities);
-        free(path);
+        MEMORY_FREE(MEMORY_PATH, path);
+        SEARCH_STATS_END(SEARCH_END_ERROR);
         return NULL;
     }
 
     fillHeapWithCitiesFromList(heap, &cities);
     deleteList(&cities);
+    SEARCH_STATS_ADD(heap_init, heap->size);
+    SEARCH_STATS_ADD(pushes, heap->size);
     if (exclude_roads != NULL)
         excludeCitiesFromRoadLists(exclude_roads, city1, city2);
     decreaseHeapKey(heap, city1->num_in_heap, 0, INT_MAX);
     heap_node = popHeap(heap);
+    SEARCH_STATS_ADD(pops, 1);
     assert(heap_node != NULL);
 
     curr_city = city1;
-    while (strcmp(curr_city->name, city2->name) != 0) {
+    while (curr_city != city2) {
         if ((heap_node->total_len == UINT_MAX && heap_node->year == INT_MAX) ||
             curr_city->num_in_heap == 0) {
             deleteHeap(heap);
-            free(path);
+            MEMORY_FREE(MEMORY_PATH, path);
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
             return false;
         }
-        roads = mapGetValuesList(curr_city->connected_roads);
-        if (roads == NULL) {
-            deleteHeap(heap);
-            free(path);
-            return NULL;
-        }
-        assert(roads != NULL);
-
-        tmp_node = roads;
-        while (tmp_node->value != NULL) {
-            Road *curr_road = (Road *) tmp_node->value;
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
             City *next_city = getNextCity(curr_city, curr_road);
             new_len = heap_node->total_len + curr_road->length;
             new_year = heap_node->year < curr_road->year ? heap_node->year
@@ -251,19 +278,19 @@ path_t *findBestPath(Map *map, City *city1, City *city2, list_t **exclude_roads,
                 if (next_city->num_in_heap != 0) {
                     if (decreaseHeapKey(heap, next_city->num_in_heap, new_len,
                                         new_year)) {
+                        SEARCH_STATS_ADD(decreased, 1);
                         next_city->prev_city = curr_city;
                     }
                 }
             }
-
-            tmp_node = tmp_node->next;
         }
 
-        deleteList(&roads);
         heap_node = popHeap(heap);
+        SEARCH_STATS_ADD(pops, 1);
         if (heap_node == NULL) {
             deleteHeap(heap);
-            free(path);
+            MEMORY_FREE(MEMORY_PATH, path);
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
             return NULL;
         }
         assert(heap_node != NULL);
@@ -273,9 +300,11 @@ path_t *findBestPath(Map *map, City *city1, City *city2, list_t **exclude_roads,
     if ((heap_node->total_len == UINT_MAX && heap_node->year == INT_MAX) ||
         curr_city->num_in_heap == 0) {
         deleteHeap(heap);
-        free(path);
+        MEMORY_FREE(MEMORY_PATH, path);
+        SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
         return false;
     }
+    SEARCH_STATS_END(SEARCH_END_TARGET);
 
     path->total_len = heap_node->total_len;
     path->year = heap_node->year;
@@ -284,22 +313,21 @@ path_t *findBestPath(Map *map, City *city1, City *city2, list_t **exclude_roads,
 
     path->roads = newList();
     if (path->roads == NULL) {
-        free(path);
+        MEMORY_FREE(MEMORY_PATH, path);
         return NULL;
     }
 
     assert(curr_city == city2);
-    while (strcmp(curr_city->name, city1->name) != 0) {
-        Road *curr_road = (Road *) mapGet(curr_city->connected_roads,
-                                          (void *) curr_city->prev_city->name);
+    while (curr_city != city1) {
+        Road *curr_road = getRoadToCity(curr_city, curr_city->prev_city);
         if (curr_road == NULL) {
             deleteList(&path->roads);
-            free(path);
+            MEMORY_FREE(MEMORY_PATH, path);
             return NULL;
         }
         if (!addList(&path->roads, (void *) curr_road)) {
             deleteList(&path->roads);
-            free(path);
+            MEMORY_FREE(MEMORY_PATH, path);
             return NULL;
         }
 
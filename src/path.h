@@ -21,4 +21,8 @@ bool checkIfPathDefinedUnambiguously(Map *map, path_t *path, City *city1,
 
 bool checkIfFirstPathBetter(path_t *path1, path_t *path2);
 
+void deletePath(path_t *path);
+
+void deletePaths(path_t **paths, size_t paths_num);
+
 #endif //ROADS_PATH_H
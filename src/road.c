@@ -9,6 +9,8 @@
 #include <string.h>
 
 #include "road.h"
+#include "road_index.h"
+#include "memory_stats.h"
 
 /** @brief Road destructor used only by avl_map module.
  * @param road [in]       - pointer to road.
@@ -25,23 +27,20 @@ void deleteRoadFromAvlMap(void *road) {
  * @return Pointer to new road or NULL if allocation error occurred.
  */
 Road *createRoad(City *city1, City *city2, unsigned length, int builtYear) {
-    Road *new_road = (Road *) malloc(sizeof(Road));
+    Road *new_road = (Road *) MEMORY_ALLOC(MEMORY_ROAD, sizeof(Road));
 
     if (new_road == NULL)
         return NULL;
 
-    new_road->partOfRoute = newList();
-    if (new_road == NULL) {
-        free(new_road);
-        return NULL;
-    }
-
     new_road->city1 = city1;
     new_road->city2 = city2;
     new_road->length = length;
     new_road->year = builtYear;
     new_road->citiesCounter = 2;
     new_road->routes_num = 0;
+    new_road->routes_capacity = ROAD_INLINE_ROUTES;
+    new_road->bridge = false;
+    initRoadIndexNode(&new_road->index_node, new_road);
     return new_road;
 }
 
@@ -50,8 +49,9 @@ Road *createRoad(City *city1, City *city2, unsigned length, int builtYear) {
  * @param road [in]       – pointer to road.
  */
 void deleteRoad(Road *road) {
-    deleteList(&road->partOfRoute);
-    free(road);
+    if (road->routes_capacity > ROAD_INLINE_ROUTES)
+        MEMORY_FREE(MEMORY_ROAD, road->routes);
+    MEMORY_FREE(MEMORY_ROAD, road);
 }
 
 /** @brief Decreases cities counter and deletes road if counter achieved 0.
@@ -79,27 +79,66 @@ bool repairSelectedRoad(Road *road, int repairYear) {
     return false;
 }
 
+/** @brief Returns array of routes containing road.
+ * Array is valid until road is marked as part of next route.
+ * @param road [in]       - pointer to road.
+ * @return Pointer to array of @p road->routes_num routes.
+ */
+Route **getRoadRoutes(Road *road) {
+    if (road->routes_capacity > ROAD_INLINE_ROUTES)
+        return road->routes;
+    return road->inline_routes;
+}
+
 /** @brief Marks that road is part of specified route.
+ * Routes are moved from inline array to heap when inline array is full.
  * @param road [in,out]   - pointer to road,
  * @param route [in,out]  – pointer to route.
  * @return Value @p true if road was successfully marked.
  * Otherwise value @p false.
  */
 bool markRoadAsPartOfRoute(Road *road, Route *route) {
-    bool result = addList(&road->partOfRoute, (void *) route);
-    if (result)
-        road->routes_num++;
-    return result;
+    Route **new_routes;
+
+    if (road->routes_num == road->routes_capacity) {
+        unsigned new_capacity = 2 * road->routes_capacity;
+
+        if (road->routes_capacity == ROAD_INLINE_ROUTES) {
+            new_routes = (Route **) MEMORY_ALLOC(MEMORY_ROAD, sizeof(Route *) *
+                                                              new_capacity);
+            if (new_routes == NULL)
+                return false;
+            memcpy(new_routes, road->inline_routes,
+                   sizeof(Route *) * road->routes_num);
+        } else {
+            new_routes = (Route **) MEMORY_REALLOC(
+                    MEMORY_ROAD, road->routes, sizeof(Route *) * new_capacity);
+            if (new_routes == NULL)
+                return false;
+        }
+        road->routes = new_routes;
+        road->routes_capacity = new_capacity;
+    }
+
+    getRoadRoutes(road)[road->routes_num++] = route;
+    return true;
 }
 
 /** @brief Marks that road is not longer part of specified road.
- * Do nothing if road wasn't part of specified road.
+ * Do nothing if road wasn't part of specified road. Order of remaining
+ * routes isn't preserved.
  * @param road [in,out]   - pointer to road,
  * @param route [in,out]  - pointer to route.
  */
 void unmarkRoadAsPartOfRoute(Road *road, Route *route) {
-    if (removeList(&road->partOfRoute, (void *) route))
-        road->routes_num--;
+    Route **routes = getRoadRoutes(road);
+
+    for (unsigned i = 0; i < road->routes_num; i++) {
+        if (routes[i] == route) {
+            routes[i] = routes[--road->routes_num];
+            return;
+        }
+    }
 }
 
 /** @brief Finds other end of road.
@@ -109,9 +148,9 @@ void unmarkRoadAsPartOfRoute(Road *road, Route *route) {
  * @return Pointer to city (other end of road) or NULL if error occurred.
  */
 City *getNextCity(City *city, Road *road) {
-    if (strcmp(road->city1->name, city->name) == 0)
+    if (road->city1 == city)
         return road->city2;
-    if (strcmp(road->city2->name, city->name) == 0)
+    if (road->city2 == city)
         return road->city1;
     return NULL;
 }
\ No newline at end of file
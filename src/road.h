@@ -20,6 +20,8 @@ void safeDeleteRoad(Road *road);
 
 bool repairSelectedRoad(Road *road, int repairYear);
 
+Route **getRoadRoutes(Road *road);
+
 bool markRoadAsPartOfRoute(Road *road, Route *route);
 
 void unmarkRoadAsPartOfRoute(Road *road, Route *route);
@@ -0,0 +1,330 @@
+/** @file
+ * Implementation of index of roads ordered by year.
+ * Index is a treap, priorities are hashes of numbers of cities of road, so
+ * shape of index doesn't depend on order of changes. Every subtree knows
+ * its size, so roads older than given year are counted in logarithmic time.
+ * Changing year of road moves its nodes in all indexes.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "memory_stats.h"
+#include "road.h"
+#include "road_index.h"
+
+/** @brief Computes priority of road in index.
+ * @param road [in]       - pointer to road.
+ * @return Hash of numbers of cities of road.
+ */
+static unsigned hashRoad(const Road *road) {
+    uint64_t hash = ((uint64_t) road->city1->id << 32) | road->city2->id;
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return (unsigned) hash;
+}
+
+/** @brief Compares key of road with key of node.
+ * Roads are ordered by year, then by number of first city of road, then by
+ * number of second city. Cities are numbered in order of adding to map.
+ * @param year [in]       - year of road,
+ * @param road [in]       - pointer to road,
+ * @param node [in]       - pointer to node.
+ * @return Negative value if road comes before node, positive if road comes
+ * after node, @p 0 if node describes road.
+ */
+static int compareKeys(int year, const Road *road,
+                       const road_index_node_t *node) {
+    const Road *node_road = node->road;
+
+    if (year != node->year)
+        return year < node->year ? -1 : 1;
+    if (road->city1->id != node_road->city1->id)
+        return road->city1->id < node_road->city1->id ? -1 : 1;
+    if (road->city2->id != node_road->city2->id)
+        return road->city2->id < node_road->city2->id ? -1 : 1;
+    return 0;
+}
+
+/** @brief Returns size of subtree.
+ * @param node [in]       - pointer to root of subtree or NULL.
+ * @return Number of nodes in subtree.
+ */
+static unsigned getSize(const road_index_node_t *node) {
+    return node == NULL ? 0 : node->size;
+}
+
+/** @brief Updates size of subtree after its children changed.
+ * @param node [in,out]   - pointer to root of subtree.
+ */
+static void updateSize(road_index_node_t *node) {
+    node->size = 1 + getSize(node->children[0]) + getSize(node->children[1]);
+}
+
+/** @brief Splits subtree into nodes before and after given node.
+ * @param root [in,out]   - pointer to root of subtree or NULL,
+ * @param node [in]       - pointer to node, which isn't in subtree,
+ * @param left [out]      - root of nodes before @p node,
+ * @param right [out]     - root of nodes after @p node.
+ */
+static void splitNodes(road_index_node_t *root, const road_index_node_t *node,
+                       road_index_node_t **left, road_index_node_t **right) {
+    if (root == NULL) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    if (compareKeys(node->year, node->road, root) > 0) {
+        *left = root;
+        splitNodes(root->children[1], node, &root->children[1], right);
+    } else {
+        *right = root;
+        splitNodes(root->children[0], node, left, &root->children[0]);
+    }
+    updateSize(root);
+}
+
+/** @brief Merges two subtrees.
+ * Assumes that all nodes of left subtree come before nodes of right subtree.
+ * @param left [in,out]   - pointer to root of left subtree or NULL,
+ * @param right [in,out]  - pointer to root of right subtree or NULL.
+ * @return Root of merged subtree.
+ */
+static road_index_node_t *mergeNodes(road_index_node_t *left,
+                                     road_index_node_t *right) {
+    if (left == NULL)
+        return right;
+    if (right == NULL)
+        return left;
+
+    if (left->priority > right->priority) {
+        left->children[1] = mergeNodes(left->children[1], right);
+        updateSize(left);
+        return left;
+    }
+    right->children[0] = mergeNodes(left, right->children[0]);
+    updateSize(right);
+    return right;
+}
+
+/** @brief Inserts node into subtree.
+ * @param root [in,out]   - pointer to root of subtree or NULL,
+ * @param node [in,out]   - pointer to inserted node.
+ * @return Root of subtree with node.
+ */
+static road_index_node_t *insertNode(road_index_node_t *root,
+                                     road_index_node_t *node) {
+    int side;
+
+    if (root == NULL || node->priority > root->priority) {
+        splitNodes(root, node, &node->children[0], &node->children[1]);
+        updateSize(node);
+        return node;
+    }
+
+    side = compareKeys(node->year, node->road, root) > 0;
+    root->children[side] = insertNode(root->children[side], node);
+    root->size++;
+    return root;
+}
+
+/** @brief Removes node of road from subtree.
+ * Assumes that subtree contains node of road with given year.
+ * @param root [in,out]   - pointer to root of subtree,
+ * @param year [in]       - year of node,
+ * @param road [in]       - pointer to road,
+ * @param removed [out]   - removed node.
+ * @return Root of subtree without node.
+ */
+static road_index_node_t *removeNode(road_index_node_t *root, int year,
+                                     const Road *road,
+                                     road_index_node_t **removed) {
+    int cmp;
+
+    assert(root != NULL);
+    cmp = compareKeys(year, road, root);
+    if (cmp == 0) {
+        *removed = root;
+        return mergeNodes(root->children[0], root->children[1]);
+    }
+
+    root->children[cmp > 0] = removeNode(root->children[cmp > 0], year, road,
+                                         removed);
+    root->size--;
+    return root;
+}
+
+/** @brief Initiates node of index of all roads, which is part of road.
+ * Year of node is year of road.
+ * @param node [out]      - pointer to node,
+ * @param road [in]       - pointer to road with set cities and year.
+ */
+void initRoadIndexNode(road_index_node_t *node, Road *road) {
+    node->road = road;
+    node->year = road->year;
+    node->priority = hashRoad(road);
+    node->size = 1;
+    node->children[0] = NULL;
+    node->children[1] = NULL;
+}
+
+/** @brief Adds road to index of all roads.
+ * @param index [in,out]  - pointer to root of index,
+ * @param road [in,out]   - pointer to road, which isn't in index.
+ */
+void indexRoad(road_index_node_t **index, Road *road) {
+    *index = insertNode(*index, &road->index_node);
+}
+
+/** @brief Removes road from index of all roads.
+ * @param index [in,out]  - pointer to root of index,
+ * @param road [in,out]   - pointer to road, which is in index.
+ */
+void unindexRoad(road_index_node_t **index, Road *road) {
+    road_index_node_t *removed;
+
+    *index = removeNode(*index, road->index_node.year, road, &removed);
+    assert(removed == &road->index_node);
+}
+
+/** @brief Moves road in indexes after its year changed.
+ * Road is moved in index of all roads and in indexes of all its routes.
+ * Nothing is allocated, so it can't fail.
+ * @param index [in,out]  - pointer to root of index of all roads,
+ * @param road [in,out]   - pointer to road, which is in index.
+ */
+void reindexRoad(road_index_node_t **index, Road *road) {
+    Route **routes = getRoadRoutes(road);
+    road_index_node_t *node;
+
+    if (road->index_node.year == road->year)
+        return;
+
+    for (unsigned i = 0; i < road->routes_num; i++) {
+        routes[i]->index = removeNode(routes[i]->index, road->index_node.year,
+                                      road, &node);
+        node->year = road->year;
+        routes[i]->index = insertNode(routes[i]->index, node);
+    }
+    unindexRoad(index, road);
+    road->index_node.year = road->year;
+    indexRoad(index, road);
+}
+
+/** @brief Adds road to index of route.
+ * Node gets year of road from index of all roads.
+ * @param route [in,out]  - pointer to route,
+ * @param road [in]       - pointer to road, which isn't in index of route.
+ * @return Value @p true if road was added. Value @p false if allocation
+ * error occurred.
+ */
+bool indexRouteRoad(Route *route, Road *road) {
+    road_index_node_t *node = (road_index_node_t *) MEMORY_ALLOC(
+            MEMORY_ROUTE, sizeof(road_index_node_t));
+
+    if (node == NULL)
+        return false;
+
+    *node = road->index_node;
+    route->index = insertNode(route->index, node);
+    return true;
+}
+
+/** @brief Removes road from index of route.
+ * @param route [in,out]  - pointer to route,
+ * @param road [in]       - pointer to road, which is in index of route.
+ */
+void unindexRouteRoad(Route *route, Road *road) {
+    road_index_node_t *removed;
+
+    route->index = removeNode(route->index, road->index_node.year, road,
+                              &removed);
+    MEMORY_FREE(MEMORY_ROUTE, removed);
+}
+
+/** @brief Deletes index of route.
+ * Doesn't delete roads.
+ * @param index [in]      - pointer to root of index or NULL.
+ */
+void deleteRoadIndex(road_index_node_t *index) {
+    if (index == NULL)
+        return;
+
+    deleteRoadIndex(index->children[0]);
+    deleteRoadIndex(index->children[1]);
+    MEMORY_FREE(MEMORY_ROUTE, index);
+}
+
+/** @brief Counts roads older than given year.
+ * @param index [in]      - pointer to root of index or NULL,
+ * @param year [in]       - year.
+ * @return Number of roads built or repaired last time before @p year.
+ */
+size_t countIndexedRoadsBefore(const road_index_node_t *index, int year) {
+    size_t count = 0;
+
+    while (index != NULL) {
+        if (index->year < year) {
+            count += 1 + getSize(index->children[0]);
+            index = index->children[1];
+        } else {
+            index = index->children[0];
+        }
+    }
+    return count;
+}
+
+/** @brief Appends roads of subtree in order of index.
+ * Used only by @ref selectOldestIndexedRoads.
+ * @param root [in]       - pointer to root of subtree or NULL,
+ * @param roads [out]     - array of roads,
+ * @param k [in]          - size of array,
+ * @param num [in]        - number of roads already in array.
+ * @return Number of roads in array.
+ */
+static size_t collectRoads(const road_index_node_t *root, Road **roads,
+                           size_t k, size_t num) {
+    if (root == NULL || num == k)
+        return num;
+
+    num = collectRoads(root->children[0], roads, k, num);
+    if (num == k)
+        return num;
+    roads[num++] = root->road;
+    return collectRoads(root->children[1], roads, k, num);
+}
+
+/** @brief Finds oldest roads.
+ * Roads with equal years are ordered by numbers of their first cities, then
+ * second cities. Visits only nodes on the way to returned roads.
+ * @param index [in]      - pointer to root of index or NULL,
+ * @param roads [out]     - array of at least @p k roads,
+ * @param k [in]          - maximal number of roads.
+ * @return Number of roads written to array.
+ */
+size_t selectOldestIndexedRoads(const road_index_node_t *index, Road **roads,
+                                size_t k) {
+    return collectRoads(index, roads, k, 0);
+}
+
+/** @brief Finds oldest road.
+ * @param index [in]      - pointer to root of index or NULL.
+ * @return Pointer to first road of index or NULL if index is empty.
+ */
+Road *getOldestIndexedRoad(const road_index_node_t *index) {
+    if (index == NULL)
+        return NULL;
+
+    while (index->children[0] != NULL)
+        index = index->children[0];
+    return index->road;
+}
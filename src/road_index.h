@@ -0,0 +1,40 @@
+/** @file
+ * Interface of index of roads ordered by year.
+ * Map keeps index of all roads and every route keeps index of its roads.
+ * Indexes are updated when roads are added, repaired or removed, and when
+ * roads are added to routes or removed from them.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_ROAD_INDEX_H
+#define ROADS_ROAD_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "roads_types.h"
+
+void initRoadIndexNode(road_index_node_t *node, Road *road);
+
+void indexRoad(road_index_node_t **index, Road *road);
+
+void unindexRoad(road_index_node_t **index, Road *road);
+
+void reindexRoad(road_index_node_t **index, Road *road);
+
+bool indexRouteRoad(Route *route, Road *road);
+
+void unindexRouteRoad(Route *route, Road *road);
+
+void deleteRoadIndex(road_index_node_t *index);
+
+size_t countIndexedRoadsBefore(const road_index_node_t *index, int year);
+
+size_t selectOldestIndexedRoads(const road_index_node_t *index, Road **roads,
+                                size_t k);
+
+Road *getOldestIndexedRoad(const road_index_node_t *index);
+
+#endif //ROADS_ROAD_INDEX_H
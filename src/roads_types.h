@@ -8,8 +8,11 @@
 #ifndef ROADS_ROADS_TYPES_H
 #define ROADS_ROADS_TYPES_H
 
+#include <stdint.h>
+
 #include "avl_map.h"
 #include "list.h"
+#include "name_pool.h"
 
 /**
  * Type representing map containing roads.
@@ -46,36 +49,133 @@ typedef struct heap heap_t;
  */
 typedef struct path path_t;
 
+/**
+ * Type representing description of road used to create route.
+ */
+typedef struct road_desc road_desc_t;
+
+/**
+ * Type representing index of connected components.
+ */
+typedef struct connectivity connectivity_t;
+
+/**
+ * Type representing workspace of path search.
+ */
+typedef struct search_workspace search_workspace_t;
+
+/**
+ * Type representing city reached within given length.
+ */
+typedef struct reach reach_t;
+
+/**
+ * Type representing distance between two cities.
+ */
+typedef struct distance distance_t;
+
+/**
+ * Type representing node of index of roads ordered by year.
+ */
+typedef struct road_index_node road_index_node_t;
+
+/**
+ * Type representing diversion of route around removed road.
+ */
+typedef struct diversion diversion_t;
+
+/**
+ * Result of search for path between two cities.
+ */
+typedef enum path_status {
+    PATH_FOUND,             /**< Path was found and is unambiguous. */
+    PATH_UNREACHABLE,       /**< Cities aren't connected. */
+    PATH_AMBIGUOUS,         /**< Path isn't defined unambiguously. */
+    PATH_INVALID,           /**< Parameter is invalid or city doesn't exist. */
+    PATH_ERROR              /**< Allocation error occurred. */
+} path_status_t;
+
 /**
  * Structure representing map of roads.
- * Contains map of cities, list of created routes and number of cities.
+ * Contains pool of city names, map of cities, list of created routes,
+ * number of cities, stamps used to track if bridges are known, index of
+ * connected components and index of roads ordered by year.
  */
 struct Map {
     unsigned cities_num;    /**< Number of cities in map. */
-    map_t *cities;          /**< Map containing cites, keys are city names,
-                                 values are pointers to cities. */
+    uint64_t bridges_stamp; /**< Number of last change of roads. */
+    uint64_t bridges_cycle_stamp; /**< Number of last change of roads which
+                                       could connect cities by new way. */
+    name_pool_t *names;     /**< Pool of interned city names. */
+    map_t *cities;          /**< Map containing cites, keys are handles of
+                                 city names, values are pointers to cities. */
     Route *routes[1000];    /**< Array of pointers to routes. */
+    connectivity_t *connectivity; /**< Index of connected components. */
+    search_workspace_t *workspace; /**< Workspace of searches done by queries,
+                                        reused between commands. */
+    search_workspace_t *bounds; /**< Workspace keeping distances to target,
+                                     which direct searches of alternative
+                                     paths. */
+    road_index_node_t *roads_index; /**< Root of index of all roads ordered
+                                         by year. */
 };
 
+/**
+ * Number of outgoing roads stored directly in city structure. If city has
+ * more roads, they are moved to array allocated on heap.
+ */
+#define CITY_INLINE_ROADS 6
+
 /**
  * Structure representing city.
- * Contains city name, list of outgoing roads and variables
- * used by Dijkstra algorithm.
+ * Contains city name, array of outgoing roads, variables
+ * used by Dijkstra algorithm and stamp of last search for bridges.
  */
 struct City {
-    char *name;             /**< Pointer to city name. */
-    map_t *connected_roads; /**< Map of outgoing roads from city.
-                                Keys are city name, values pointers to roads. */
+    const char *name;       /**< Handle of city name in map's pool. */
+    unsigned id;            /**< City number, unique in map. */
+    unsigned roads_num;     /**< Number of outgoing roads. */
+    unsigned roads_capacity; /**< Size of array of outgoing roads. */
+    Road **roads;           /**< Array of outgoing roads sorted by number of
+                                 second city. Points to @p inline_roads
+                                 until city has more than
+                                 @ref CITY_INLINE_ROADS roads. */
+    Road *inline_roads[CITY_INLINE_ROADS]; /**< Inline array of roads. */
 
     unsigned num_in_heap;   /**< Number of heap node with this city */
     City *prev_city;        /**< Pointer to previous city in Dijkstra algorithm. */
+    uint64_t bridges_stamp; /**< Stamp of map when bridges in component of
+                                 city were found. */
+};
+
+/**
+ * Number of routes stored directly in road structure. If road is part of more
+ * routes, they are moved to array allocated on heap.
+ */
+#define ROAD_INLINE_ROUTES 2
+
+/**
+ * Structure representing node of index of roads ordered by year.
+ * Index is a treap ordered by year of road and numbers of its cities, with
+ * sizes of subtrees. Node of index of all roads is part of road, nodes of
+ * indexes of routes are allocated separately. Year of node is updated
+ * together in all indexes, so it can differ from year of road only while
+ * road is being modified.
+ */
+struct road_index_node {
+    Road *road;             /**< Pointer to indexed road. */
+    int year;               /**< Year of road when it was indexed. */
+    unsigned priority;      /**< Priority of node, greater in parent. */
+    unsigned size;          /**< Number of nodes in subtree. */
+    road_index_node_t *children[2]; /**< Left and right subtree. */
 };
 
 /**
  * Structure representing road.
  * Contains pointers to city which road connects, length in km, built year
- * or year of last repair, list of routes which contain this road and
- * counter how many of connected cities still exist.
+ * or year of last repair, array of routes which contain this road, flag
+ * indicating if road is bridge and counter how many of connected cities
+ * still exist.
  * Counter is used only during deleting map of roads.
  */
 struct Road {
@@ -83,22 +183,36 @@ struct Road {
     City *city2;            /**< Pointer to last city. */
     unsigned length;        /**< Length of road. */
     int year;               /**< Built year or year of last repair. */
-    list_t *partOfRoute;    /**< List of pointers to routes containing road. */
     unsigned routes_num;    /**< Number of routes containing road. */
+    unsigned routes_capacity; /**< Size of array of routes. Routes are stored
+                                   inline if it is equal to
+                                   @ref ROAD_INLINE_ROUTES. */
+    union {
+        Route *inline_routes[ROAD_INLINE_ROUTES]; /**< Inline array of
+                                                       routes. */
+        Route **routes;     /**< Array of routes allocated on heap. */
+    };
 
     int citiesCounter;      /**< Counts how many of connected cities exist. */
+    bool bridge;            /**< Flag indicating if removing road disconnects
+                                 its cities. Valid only if stamp of its
+                                 cities is equal to stamp of map. */
+    road_index_node_t index_node; /**< Node of index of all roads. */
 };
 
 /**
  * Structure representing route.
- * Contains route number, pointer to first and last city of route and
- * list of pointers to roads making this route.
+ * Contains route number, pointer to first and last city of route,
+ * list of pointers to roads making this route and index of its roads
+ * ordered by year.
  */
 struct Route {
     unsigned routeId;       /**< Route number. */
     City *firstCity;        /**< Pointer to first city. */
     City *lastCity;         /**< Pointer to last city. */
     list_t *roads;          /**< List of pointers to roads making this route. */
+    road_index_node_t *index; /**< Root of index of roads of route, which
+                                   gives its oldest road. */
 };
 
 /**
@@ -132,4 +246,48 @@ struct path {
     int year;               /**< Year of oldest road. */
 };
 
+/**
+ * Structure representing distance between two cities.
+ * Contains length of best path and year of oldest road on it, which are
+ * compared like paths in @ref findBestPath.
+ */
+struct distance {
+    bool reachable;         /**< Flag indicating if any path exists. */
+    unsigned length;        /**< Length of best path. */
+    int year;               /**< Year of oldest road on best path, INT_MAX
+                                 if path is empty. */
+};
+
+/**
+ * Structure representing city reached within given length.
+ */
+struct reach {
+    const char *name;       /**< City name. */
+    unsigned length;        /**< Length of best path to city. */
+};
+
+/**
+ * Structure representing diversion of route around removed road.
+ * Diversion leads from city of road which comes first in route, like
+ * diversion found by @ref removeRoad.
+ */
+struct diversion {
+    Route *route;           /**< Pointer to diverted route. */
+    City *city1;            /**< City of road which comes first in route. */
+    City *city2;            /**< City of road which comes last in route. */
+    path_t *path;           /**< Diversion or NULL if it wasn't found. */
+    path_status_t status;   /**< Result of search for diversion. */
+};
+
+/**
+ * Structure describing road of route created by @ref createRoute.
+ * City names aren't copied.
+ */
+struct road_desc {
+    const char *city1;      /**< Pointer to name of first city. */
+    const char *city2;      /**< Pointer to name of second city. */
+    unsigned length;        /**< Length of road. */
+    int year;               /**< Built year or year of last repair. */
+};
+
 #endif //ROADS_ROADS_TYPES_H
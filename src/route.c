@@ -5,20 +5,22 @@
  * @date 21.07.2020
  */
 
-#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdbool.h>
 #include <string.h>
 
+#include "memory_stats.h"
 #include "road.h"
+#include "road_index.h"
 #include "route.h"
 #include "utils.h"
 
 /** @brief Creates new route with specified number.
  * Creates route with number @p routeId from @p city1 to @p city2 made by
- * specified roads (@p roads).
+ * specified roads (@p roads). Index of roads of route is empty until roads
+ * are marked as part of route.
  * @param routeId [in]    - route number,
  * @param city1 [in]      - pointer to first city,
  * @param city2 [in]      - pointer to last city,
@@ -26,7 +28,7 @@
  * @return Pointer to new route or NULL if allocation error occurred.
  */
 Route *createNewRoute(unsigned routeId, City *city1, City *city2, list_t *roads) {
-    Route *new_route = (Route *) malloc(sizeof(Route));
+    Route *new_route = (Route *) MEMORY_ALLOC(MEMORY_ROUTE, sizeof(Route));
 
     if (new_route == NULL)
         return NULL;
@@ -35,6 +37,7 @@ Route *createNewRoute(unsigned routeId, City *city1, City *city2, list_t *roads)
     new_route->firstCity = city1;
     new_route->lastCity = city2;
     new_route->roads = roads;
+    new_route->index = NULL;
     return new_route;
 }
 
@@ -47,7 +50,8 @@ void deleteRoute(Route *route) {
         return;
 
     deleteList(&route->roads);
-    free(route);
+    deleteRoadIndex(route->index);
+    MEMORY_FREE(MEMORY_ROUTE, route);
 }
 
 /** @brief Replaces road by list of other roads.
@@ -66,7 +70,7 @@ bool replaceRoad(Route *route, Road *road, list_t **roads) {
     while (tmp_node != NULL) {
         if (tmp_node->value == (void *) road) {
             tmp_node2 = tmp_node->next;
-            free(tmp_node);
+            MEMORY_FREE(MEMORY_LIST, tmp_node);
             if (prev != NULL) {
                 prev->next = *roads;
             } else {
@@ -75,7 +79,7 @@ bool replaceRoad(Route *route, Road *road, list_t **roads) {
             tmp_node = *roads;
             while (tmp_node->next != NULL && tmp_node->next->value != NULL)
                 tmp_node = tmp_node->next;
-            free(tmp_node->next);
+            MEMORY_FREE(MEMORY_LIST, tmp_node->next);
             tmp_node->next = tmp_node2;
             return true;
         }
@@ -100,7 +104,7 @@ bool extendRouteInDirection(Route *route, list_t **roads, City *new_city,
         tmp_node = route->roads;
         while (tmp_node->next != NULL && tmp_node->next->value != NULL)
             tmp_node = tmp_node->next;
-        free(tmp_node->next);
+        MEMORY_FREE(MEMORY_LIST, tmp_node->next);
         tmp_node->next = *roads;
         route->lastCity = new_city;
         return true;
@@ -108,7 +112,7 @@ bool extendRouteInDirection(Route *route, list_t **roads, City *new_city,
         tmp_node = *roads;
         while (tmp_node->next != NULL && tmp_node->next->value != NULL)
             tmp_node = tmp_node->next;
-        free(tmp_node->next);
+        MEMORY_FREE(MEMORY_LIST, tmp_node->next);
         tmp_node->next = route->roads;
         route->roads = *roads;
         route->firstCity = new_city;
@@ -116,35 +120,25 @@ bool extendRouteInDirection(Route *route, list_t **roads, City *new_city,
     }
 }
 
-/** @brief Fill given buffer with route description.
+/** @brief Fill given buffer with description of path.
  * Assumes that buffer is large enough to contain description.
  * Description is in format:
- * route number;city name;length of road;built/repair year;city name;...;
- * city name.
- * Cities are in order so that cities @p city1 and @p city2 used in @ref newRoute
- * function was in the same order.
- * @param route [in,out]  – pointer to route,
+ * city name;length of road;built/repair year;city name;...;city name.
+ * @param first_city [in] – pointer to first city of path,
+ * @param roads [in]      – list of roads making path, starting from
+ *                          @p first_city,
  * @param buffer [in,out] – pointer to buffer with description.
  */
-void fillRouteDescription(Route *route, char *buffer) {
+void fillPathDescription(City *first_city, list_t *roads, char *buffer) {
     size_t offset = 0;
     size_t len;
-    City *curr_city;
-    list_t *tmp_node;
+    City *curr_city = first_city;
+    list_t *tmp_node = roads;
     Road *curr_road;
 
-    len = getNumberLength(route->routeId);
-    snprintf(buffer, len + 2, "%d;", route->routeId);
-    offset += len + 1;
-
-    curr_city = route->firstCity;
-    tmp_node = route->roads;
-    while (curr_city != route->lastCity) {
-        assert(tmp_node != NULL);
+    while (tmp_node != NULL && tmp_node->value != NULL) {
         curr_road = (Road *) tmp_node->value;
 
-        assert(curr_road != NULL);
-
         len = strlen(curr_city->name);
         snprintf(buffer + offset, len + 2, "%s;",
                  curr_city->name);
@@ -161,32 +155,25 @@ void fillRouteDescription(Route *route, char *buffer) {
         curr_city = getNextCity(curr_city, curr_road);
         tmp_node = tmp_node->next;
     }
-    assert(tmp_node == NULL || tmp_node->value == NULL);
     len = strlen(curr_city->name);
     snprintf(buffer + offset, len + 1, "%s", curr_city->name);
 }
 
-/** Calculates size of route description.
- * @param route [in,out]  – pointer to route.
- * @return Size of route description.
+/** Calculates size of description of path.
+ * @param first_city [in] – pointer to first city of path,
+ * @param roads [in]      – list of roads making path, starting from
+ *                          @p first_city.
+ * @return Size of description of path.
  */
-size_t getRouteDescriptionLength(Route *route) {
+size_t getPathDescriptionLength(City *first_city, list_t *roads) {
     size_t len = 0;
-    City *curr_city;
-    list_t *tmp_node;
+    City *curr_city = first_city;
+    list_t *tmp_node = roads;
     Road *curr_road;
 
-    len += getNumberLength(route->routeId);
-    len++;
-
-    curr_city = route->firstCity;
-    tmp_node = route->roads;
-    while (curr_city != route->lastCity) {
-        assert(tmp_node != NULL);
+    while (tmp_node != NULL && tmp_node->value != NULL) {
         curr_road = (Road *) tmp_node->value;
 
-        assert(curr_road != NULL);
-
         len += strlen(curr_city->name);
         len++;
 
@@ -199,11 +186,36 @@ size_t getRouteDescriptionLength(Route *route) {
         curr_city = getNextCity(curr_city, curr_road);
         tmp_node = tmp_node->next;
     }
-    assert(tmp_node == NULL || tmp_node->value == NULL);
     len += strlen(curr_city->name);
     return len;
 }
 
+/** @brief Fill given buffer with route description.
+ * Assumes that buffer is large enough to contain description.
+ * Description is in format:
+ * route number;city name;length of road;built/repair year;city name;...;
+ * city name.
+ * Cities are in order so that cities @p city1 and @p city2 used in @ref newRoute
+ * function was in the same order.
+ * @param route [in,out]  – pointer to route,
+ * @param buffer [in,out] – pointer to buffer with description.
+ */
+void fillRouteDescription(Route *route, char *buffer) {
+    size_t len = getNumberLength(route->routeId);
+
+    snprintf(buffer, len + 2, "%d;", route->routeId);
+    fillPathDescription(route->firstCity, route->roads, buffer + len + 1);
+}
+
+/** Calculates size of route description.
+ * @param route [in,out]  – pointer to route.
+ * @return Size of route description.
+ */
+size_t getRouteDescriptionLength(Route *route) {
+    return getNumberLength(route->routeId) + 1 +
+           getPathDescriptionLength(route->firstCity, route->roads);
+}
+
 /** @brief Checks if first city comes first in route.
  * @param route [in,out]  - pointer to route,
  * @param city1 [in,out]  - pointer to first city,
@@ -19,6 +19,10 @@ bool replaceRoad(Route *route, Road *road, list_t **roads);
 bool extendRouteInDirection(Route *route, list_t **roads, City *new_city,
                             bool from_last);
 
+void fillPathDescription(City *first_city, list_t *roads, char *buffer);
+
+size_t getPathDescriptionLength(City *first_city, list_t *roads);
+
 void fillRouteDescription(Route *route, char *buffer);
 
 size_t getRouteDescriptionLength(Route *route);
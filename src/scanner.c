@@ -0,0 +1,123 @@
+/** @file
+ * Implementation of text line scanner.
+ * If SSE2 is available, line is scanned in blocks of 16 bytes.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <stdlib.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "scanner.h"
+#include "memory_stats.h"
+
+/** @brief Checks if character is control character.
+ * Terminating characters '\n' and '\0' are control characters too.
+ * @param c [in]       - character.
+ * @return Value @p true if @p c is control character. Otherwise value
+ * @p false.
+ */
+static inline bool isControl(char c) {
+    return (unsigned char) c < 32;
+}
+
+/** @brief Adds mark at given position.
+ * @param scan [in,out]    - pointer to scan result,
+ * @param pos [in]         - position of mark.
+ * @return Value @p true if mark was added. Value @p false if allocation
+ * error occurred.
+ */
+static bool addMark(line_scan_t *scan, size_t pos) {
+    if (scan->marks_num == scan->marks_capacity) {
+        size_t new_capacity = scan->marks_capacity == 0
+                              ? 32 : 2 * scan->marks_capacity;
+        size_t *new_marks = (size_t *) MEMORY_REALLOC(
+                MEMORY_PARSER, scan->marks, sizeof(size_t) * new_capacity);
+        if (new_marks == NULL)
+            return false;
+        scan->marks = new_marks;
+        scan->marks_capacity = new_capacity;
+    }
+    scan->marks[scan->marks_num++] = pos;
+    return true;
+}
+
+/** @brief Initiates empty scan result.
+ * @param scan [out]       - pointer to scan result.
+ */
+void initLineScan(line_scan_t *scan) {
+    scan->len = 0;
+    scan->marks = NULL;
+    scan->marks_num = 0;
+    scan->marks_capacity = 0;
+}
+
+/** @brief Frees buffers of scan result.
+ * @param scan [in,out]    - pointer to scan result.
+ */
+void clearLineScan(line_scan_t *scan) {
+    MEMORY_FREE(MEMORY_PARSER, scan->marks);
+    initLineScan(scan);
+}
+
+/** @brief Scans text line.
+ * Finds end of line, which is first '\n' or '\0' or end of text, and
+ * marks all semicolons and control characters before it. Text has to be
+ * followed by @ref SCAN_PADDING readable bytes.
+ * @param scan [in,out]    - pointer to scan result,
+ * @param text [in]        - pointer to text,
+ * @param len [in]         - length of text.
+ * @return Value @p true if line was scanned. Value @p false if allocation
+ * error occurred.
+ */
+bool scanLine(line_scan_t *scan, const char *text, size_t len) {
+    size_t pos = 0;
+
+    scan->marks_num = 0;
+
+#ifdef __SSE2__
+    const __m128i semicolon = _mm_set1_epi8(';');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i minus_one = _mm_set1_epi8(-1);
+
+    for (; pos < len; pos += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (text + pos));
+        __m128i control = _mm_and_si128(_mm_cmplt_epi8(block, space),
+                                        _mm_cmpgt_epi8(block, minus_one));
+        unsigned ends = (unsigned) _mm_movemask_epi8(_mm_or_si128(
+                _mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, zero)));
+        unsigned marks = (unsigned) _mm_movemask_epi8(_mm_or_si128(
+                _mm_cmpeq_epi8(block, semicolon), control));
+        size_t block_len = len - pos < 16 ? len - pos : 16;
+
+        if (block_len < 16)
+            ends |= 1u << block_len;
+        if (ends != 0)
+            marks &= (1u << __builtin_ctz(ends)) - 1;
+
+        while (marks != 0) {
+            if (!addMark(scan, pos + (size_t) __builtin_ctz(marks)))
+                return false;
+            marks &= marks - 1;
+        }
+
+        if (ends != 0) {
+            scan->len = pos + (size_t) __builtin_ctz(ends);
+            return true;
+        }
+    }
+#endif
+
+    for (; pos < len && text[pos] != '\n' && text[pos] != '\0'; pos++) {
+        if ((text[pos] == ';' || isControl(text[pos])) && !addMark(scan, pos))
+            return false;
+    }
+    scan->len = pos;
+    return true;
+}
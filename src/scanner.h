@@ -0,0 +1,39 @@
+/** @file
+ * Interface of text line scanner.
+ * Scanner finds in one pass end of line and positions of all characters
+ * significant for parsing: semicolons and control characters.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_SCANNER_H
+#define ROADS_SCANNER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Macro defining number of bytes after scanned text, which have to be
+ * readable. Scanner reads whole blocks of this size.
+ */
+#define SCAN_PADDING 16
+
+/**
+ * Structure storing result of scanning line.
+ */
+typedef struct line_scan {
+    size_t len;                 /**< Length of line till first '\n' or '\0'. */
+    size_t *marks;              /**< Positions of ';' and control characters,
+                                     in increasing order. */
+    size_t marks_num;           /**< Number of marks. */
+    size_t marks_capacity;      /**< Size of array of marks. */
+} line_scan_t;
+
+void initLineScan(line_scan_t *scan);
+
+void clearLineScan(line_scan_t *scan);
+
+bool scanLine(line_scan_t *scan, const char *text, size_t len);
+
+#endif //ROADS_SCANNER_H
@@ -0,0 +1,1087 @@
+/** @file
+ * Implementation of module finding best path using reusable workspace.
+ * Works like module path, but distances and previous cities are stored in
+ * arrays indexed by city number. Arrays aren't cleared between searches,
+ * entry is valid only if its stamp is equal to number of current search.
+ * Heap contains only reached cities, so search visits only cities which
+ * are closer than target city.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "search.h"
+#include "city.h"
+#include "list.h"
+#include "memory_stats.h"
+#include "path.h"
+#include "road.h"
+#include "search_stats.h"
+
+/**
+ * State of city in current search.
+ */
+typedef enum city_state {
+    CITY_UNSEEN,                /**< City wasn't reached. */
+    CITY_QUEUED,                /**< City is in heap. */
+    CITY_SETTLED,               /**< City was removed from heap. */
+    CITY_EXCLUDED               /**< City can't be used. */
+} city_state_t;
+
+/**
+ * Structure representing workspace of path search.
+ */
+struct search_workspace {
+    unsigned capacity;          /**< Number of cities in arrays. */
+    unsigned generation;        /**< Number of current search. */
+    unsigned *stamps;           /**< Number of search which reached city. */
+    unsigned char *states;      /**< States of cities. */
+    unsigned *lengths;          /**< Distances from start city. */
+    int *years;                 /**< Years of oldest road on that way. */
+    City **prev_cities;         /**< Previous cities. */
+    unsigned *positions;        /**< Positions of cities in heap. */
+    City **heap;                /**< Heap of cities, first node has number 1. */
+    unsigned heap_size;         /**< Number of cities in heap. */
+};
+
+/** @brief Creates empty workspace.
+ * Workspace grows with map.
+ * @return Pointer to workspace or NULL if allocation error occurred.
+ */
+search_workspace_t *createSearchWorkspace() {
+    search_workspace_t *workspace =
+            (search_workspace_t *) MEMORY_CALLOC(MEMORY_PATH, 1,
+                                                 sizeof(search_workspace_t));
+
+    return workspace;
+}
+
+/** @brief Deletes workspace.
+ * @param workspace [in]   - pointer to workspace.
+ */
+void deleteSearchWorkspace(search_workspace_t *workspace) {
+    if (workspace == NULL)
+        return;
+    MEMORY_FREE(MEMORY_PATH, workspace->stamps);
+    MEMORY_FREE(MEMORY_PATH, workspace->states);
+    MEMORY_FREE(MEMORY_PATH, workspace->lengths);
+    MEMORY_FREE(MEMORY_PATH, workspace->years);
+    MEMORY_FREE(MEMORY_PATH, workspace->prev_cities);
+    MEMORY_FREE(MEMORY_PATH, workspace->positions);
+    MEMORY_FREE(MEMORY_PATH, workspace->heap);
+    MEMORY_FREE(MEMORY_PATH, workspace);
+}
+
+/** @brief Reallocates array.
+ * Array isn't changed if allocation error occurred.
+ * @param array [in,out]   - pointer to array,
+ * @param size [in]        - new size in bytes.
+ * @return Value @p true if array was reallocated. Otherwise value @p false.
+ */
+static bool resizeArray(void **array, size_t size) {
+    void *new_array = MEMORY_REALLOC(MEMORY_PATH, *array, size);
+
+    if (new_array == NULL)
+        return false;
+    *array = new_array;
+    return true;
+}
+
+/** @brief Prepares workspace to new search in map.
+ * Every search starts with heap containing only its source, so initial size
+ * of heap is counted here.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param map [in]           - pointer to map.
+ * @return Value @p true if workspace is ready. Value @p false if allocation
+ * error occurred.
+ */
+static bool beginSearch(search_workspace_t *workspace, Map *map) {
+    if (map->cities_num > workspace->capacity) {
+        unsigned capacity = workspace->capacity < 64 ? 64
+                                                     : workspace->capacity;
+
+        while (capacity < map->cities_num)
+            capacity *= 2;
+        if (!resizeArray((void **) &workspace->stamps,
+                         sizeof(unsigned) * capacity) ||
+            !resizeArray((void **) &workspace->states, capacity) ||
+            !resizeArray((void **) &workspace->lengths,
+                         sizeof(unsigned) * capacity) ||
+            !resizeArray((void **) &workspace->years, sizeof(int) * capacity) ||
+            !resizeArray((void **) &workspace->prev_cities,
+                         sizeof(City *) * capacity) ||
+            !resizeArray((void **) &workspace->positions,
+                         sizeof(unsigned) * capacity) ||
+            !resizeArray((void **) &workspace->heap,
+                         sizeof(City *) * (capacity + 1)))
+            return false;
+        memset(workspace->stamps + workspace->capacity, 0,
+               sizeof(unsigned) * (capacity - workspace->capacity));
+        workspace->capacity = capacity;
+    }
+
+    workspace->generation++;
+    if (workspace->generation == 0) {
+        memset(workspace->stamps, 0, sizeof(unsigned) * workspace->capacity);
+        workspace->generation = 1;
+    }
+    workspace->heap_size = 0;
+    SEARCH_STATS_ADD(heap_init, 1);
+    return true;
+}
+
+/** @brief Returns state of city in current search.
+ * @param workspace [in]   - pointer to workspace,
+ * @param city [in]        - pointer to city.
+ * @return State of city.
+ */
+static inline city_state_t getCityState(search_workspace_t *workspace,
+                                        City *city) {
+    if (workspace->stamps[city->id] != workspace->generation)
+        return CITY_UNSEEN;
+    return (city_state_t) workspace->states[city->id];
+}
+
+/** @brief Sets state of city in current search.
+ * City reached first time has no previous city.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param city [in]          - pointer to city,
+ * @param state [in]         - new state.
+ */
+static inline void setCityState(search_workspace_t *workspace, City *city,
+                                city_state_t state) {
+    if (workspace->stamps[city->id] != workspace->generation) {
+        workspace->stamps[city->id] = workspace->generation;
+        workspace->prev_cities[city->id] = NULL;
+    }
+    workspace->states[city->id] = (unsigned char) state;
+}
+
+/** @brief Checks if first city has better key.
+ * Key is better if distance is smaller or distances are equal and year
+ * is not smaller.
+ * @param workspace [in]   - pointer to workspace,
+ * @param city1 [in]       - pointer to first city,
+ * @param city2 [in]       - pointer to second city.
+ * @return Value @p true if first city is better. Otherwise value @p false.
+ */
+static inline bool checkIfFirstCityBetter(search_workspace_t *workspace,
+                                          City *city1, City *city2) {
+    unsigned len1 = workspace->lengths[city1->id];
+    unsigned len2 = workspace->lengths[city2->id];
+
+    if (len1 != len2)
+        return len1 < len2;
+    return workspace->years[city1->id] >= workspace->years[city2->id];
+}
+
+/** @brief Moves city in heap up until heap property is restored.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param node [in]          - number of heap node with city.
+ */
+static void siftUp(search_workspace_t *workspace, unsigned node) {
+    City **heap = workspace->heap;
+    City *city = heap[node];
+
+    while (node > 1 && !checkIfFirstCityBetter(workspace, heap[node / 2],
+                                               city)) {
+        heap[node] = heap[node / 2];
+        workspace->positions[heap[node]->id] = node;
+        node /= 2;
+    }
+    heap[node] = city;
+    workspace->positions[city->id] = node;
+}
+
+/** @brief Moves city in heap down until heap property is restored.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param node [in]          - number of heap node with city.
+ */
+static void siftDown(search_workspace_t *workspace, unsigned node) {
+    City **heap = workspace->heap;
+    City *city = heap[node];
+    unsigned next;
+
+    while (2 * node <= workspace->heap_size) {
+        next = 2 * node;
+        if (next + 1 <= workspace->heap_size &&
+            !checkIfFirstCityBetter(workspace, heap[next], heap[next + 1]))
+            next++;
+        if (checkIfFirstCityBetter(workspace, city, heap[next]))
+            break;
+        heap[node] = heap[next];
+        workspace->positions[heap[node]->id] = node;
+        node = next;
+    }
+    heap[node] = city;
+    workspace->positions[city->id] = node;
+}
+
+/** @brief Sets key of city and adds it to heap or moves it in heap.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param city [in]          - pointer to city,
+ * @param len [in]           - new distance,
+ * @param year [in]          - new year.
+ */
+static void pushCity(search_workspace_t *workspace, City *city, unsigned len,
+                     int year) {
+    workspace->lengths[city->id] = len;
+    workspace->years[city->id] = year;
+    if (getCityState(workspace, city) == CITY_QUEUED) {
+        siftUp(workspace, workspace->positions[city->id]);
+    } else {
+        setCityState(workspace, city, CITY_QUEUED);
+        workspace->heap[++workspace->heap_size] = city;
+        siftUp(workspace, workspace->heap_size);
+        SEARCH_STATS_ADD(pushes, 1);
+    }
+}
+
+/** @brief Removes best city from heap and marks it as settled.
+ * @param workspace [in,out] - pointer to workspace.
+ * @return Pointer to city or NULL if heap is empty.
+ */
+static City *popCity(search_workspace_t *workspace) {
+    City *city;
+
+    if (workspace->heap_size == 0)
+        return NULL;
+    city = workspace->heap[1];
+    workspace->heap[1] = workspace->heap[workspace->heap_size--];
+    if (workspace->heap_size > 0)
+        siftDown(workspace, 1);
+    setCityState(workspace, city, CITY_SETTLED);
+    return city;
+}
+
+/** @brief Decreases key of city if new key is not worse.
+ * Unseen city is added to heap, settled and excluded cities aren't changed.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param city [in]          - pointer to city,
+ * @param len [in]           - new distance,
+ * @param year [in]          - new year.
+ * @return Value @p true if key was changed. Otherwise value @p false.
+ */
+static bool decreaseCityKey(search_workspace_t *workspace, City *city,
+                            unsigned len, int year) {
+    switch (getCityState(workspace, city)) {
+        case CITY_UNSEEN:
+            break;
+        case CITY_QUEUED:
+            if (workspace->lengths[city->id] < len)
+                return false;
+            if (workspace->lengths[city->id] == len &&
+                workspace->years[city->id] > year)
+                return false;
+            break;
+        default:
+            return false;
+    }
+    pushCity(workspace, city, len, year);
+    return true;
+}
+
+/** @brief Excludes cities from search.
+ * Excludes every city that is end of any road from list, but not @p city1
+ * and @p city2.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param roads [in]         - pointer to roads list,
+ * @param city1 [in]         - pointer to first city,
+ * @param city2 [in]         - pointer to last city.
+ */
+static void excludeCities(search_workspace_t *workspace, list_t **roads,
+                          City *city1, City *city2) {
+    list_t *tmp_node = *roads;
+    Road *curr_road;
+
+    while (tmp_node != NULL && tmp_node->value != NULL) {
+        curr_road = (Road *) tmp_node->value;
+        if (curr_road->city1 != city1 && curr_road->city1 != city2)
+            setCityState(workspace, curr_road->city1, CITY_EXCLUDED);
+        if (curr_road->city2 != city1 && curr_road->city2 != city2)
+            setCityState(workspace, curr_road->city2, CITY_EXCLUDED);
+        tmp_node = tmp_node->next;
+    }
+}
+
+/** @brief Checks if road can be used in search.
+ * Year of road is read anyway to find oldest road of path, so comparing it
+ * with @p min_year costs no additional memory access.
+ * @param curr_city [in]     - pointer to city from which road is used,
+ * @param curr_road [in]     - pointer to road,
+ * @param next_city [in]     - pointer to other end of road,
+ * @param city1 [in]         - pointer to first city,
+ * @param city2 [in]         - pointer to last city,
+ * @param direct [in]        - flag indicating if direct road can be used,
+ * @param min_year [in]      - oldest year of road which can be used.
+ * @return Value @p true if road can be used. Otherwise value @p false.
+ */
+static inline bool checkIfRoadAllowed(City *curr_city, Road *curr_road,
+                                      City *next_city, City *city1,
+                                      City *city2, bool direct,
+                                      int min_year) {
+    if (curr_road->year < min_year)
+        return false;
+    return direct || !((curr_city == city1 && next_city == city2) ||
+                       (curr_city == city2 && next_city == city1));
+}
+
+/** @brief Finds best path between two cities.
+ * Gives the same path as @ref findBestPath called with the same arguments,
+ * if @p min_year is INT_MIN. Otherwise only roads built or repaired in
+ * @p min_year or later are used.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param map [in]           - pointer to map,
+ * @param city1 [in]         - pointer to first city,
+ * @param city2 [in]         - pointer to last city,
+ * @param exclude_roads [in] - list of excluded roads and cities,
+ * @param direct [in]        - flag indicating if direct road can be used,
+ * @param min_year [in]      - oldest year of road which can be used,
+ * @param status [out]       - result of search.
+ * @return Pointer to path or NULL if allocation error occurred or @p city2
+ * is not reachable from @p city1.
+ */
+path_t *searchBestPath(search_workspace_t *workspace, Map *map, City *city1,
+                       City *city2, list_t **exclude_roads, bool direct,
+                       int min_year, path_status_t *status) {
+    City *curr_city;
+    path_t *path;
+    unsigned new_len;
+    int new_year;
+
+    *status = PATH_ERROR;
+    if (!beginSearch(workspace, map)) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        return NULL;
+    }
+    if (exclude_roads != NULL)
+        excludeCities(workspace, exclude_roads, city1, city2);
+    pushCity(workspace, city1, 0, INT_MAX);
+
+    while ((curr_city = popCity(workspace)) != city2) {
+        SEARCH_STATS_ADD(pops, 1);
+        if (curr_city == NULL) {
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
+            *status = PATH_UNREACHABLE;
+            return NULL;
+        }
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
+            City *next_city = getNextCity(curr_city, curr_road);
+
+            if (!checkIfRoadAllowed(curr_city, curr_road, next_city, city1,
+                                    city2, direct, min_year))
+                continue;
+            new_len = workspace->lengths[curr_city->id] + curr_road->length;
+            new_year = workspace->years[curr_city->id] < curr_road->year
+                       ? workspace->years[curr_city->id] : curr_road->year;
+            if (decreaseCityKey(workspace, next_city, new_len, new_year)) {
+                SEARCH_STATS_ADD(decreased, 1);
+                workspace->prev_cities[next_city->id] = curr_city;
+            }
+        }
+    }
+    SEARCH_STATS_ADD(pops, 1);
+    SEARCH_STATS_END(SEARCH_END_TARGET);
+
+    path = (path_t *) MEMORY_ALLOC(MEMORY_PATH, sizeof(path_t));
+    if (path == NULL)
+        return NULL;
+    path->total_len = workspace->lengths[city2->id];
+    path->year = workspace->years[city2->id];
+    path->roads = newList();
+    if (path->roads == NULL) {
+        MEMORY_FREE(MEMORY_PATH, path);
+        return NULL;
+    }
+
+    while (curr_city != city1) {
+        City *prev_city = workspace->prev_cities[curr_city->id];
+        Road *curr_road = getRoadToCity(curr_city, prev_city);
+
+        if (curr_road == NULL || !addList(&path->roads, (void *) curr_road)) {
+            deleteList(&path->roads);
+            MEMORY_FREE(MEMORY_PATH, path);
+            return NULL;
+        }
+        curr_city = prev_city;
+    }
+    *status = PATH_FOUND;
+    return path;
+}
+
+/** @brief Checks if path was selected unambiguously.
+ * Gives the same result as @ref checkIfPathDefinedUnambiguously called with
+ * the same arguments, if @p min_year is INT_MIN. Cities from path get their
+ * distances and previous cities first. Path is ambiguous if Dijkstra
+ * algorithm reaches any of them not from previous city by way not worse
+ * than path.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param map [in]           - pointer to map,
+ * @param path [in]          - pointer to path,
+ * @param city1 [in]         - pointer to first city,
+ * @param city2 [in]         - pointer to last city,
+ * @param exclude_roads [in] - list of excluded roads and cities,
+ * @param direct [in]        - flag indicating if direct road can be used,
+ * @param min_year [in]      - oldest year of road which can be used.
+ * @return Value @p true if path was selected unambiguously.
+ * Otherwise value @p false.
+ */
+bool searchIfPathDefinedUnambiguously(search_workspace_t *workspace, Map *map,
+                                      path_t *path, City *city1, City *city2,
+                                      list_t **exclude_roads, bool direct,
+                                      int min_year) {
+    City *curr_city;
+    list_t *tmp_node;
+    unsigned new_len;
+    int new_year;
+
+    if (!beginSearch(workspace, map)) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        return false;
+    }
+    if (exclude_roads != NULL)
+        excludeCities(workspace, exclude_roads, city1, city2);
+    pushCity(workspace, city1, 0, INT_MAX);
+    popCity(workspace);
+    SEARCH_STATS_ADD(pops, 1);
+
+    new_len = 0;
+    new_year = INT_MAX;
+    curr_city = city1;
+    tmp_node = path->roads;
+    while (curr_city != city2) {
+        Road *curr_road = (Road *) tmp_node->value;
+        City *next_city = getNextCity(curr_city, curr_road);
+
+        new_len += curr_road->length;
+        new_year = new_year < curr_road->year ? new_year : curr_road->year;
+        decreaseCityKey(workspace, next_city, new_len, new_year);
+        SEARCH_STATS_ADD(decreased, 1);
+        workspace->prev_cities[next_city->id] = curr_city;
+
+        curr_city = next_city;
+        tmp_node = tmp_node->next;
+    }
+
+    curr_city = city1;
+    while (curr_city != city2) {
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
+            City *next_city = getNextCity(curr_city, curr_road);
+
+            if (!checkIfRoadAllowed(curr_city, curr_road, next_city, city1,
+                                    city2, direct, min_year))
+                continue;
+            new_len = workspace->lengths[curr_city->id] + curr_road->length;
+            new_year = workspace->years[curr_city->id] < curr_road->year
+                       ? workspace->years[curr_city->id] : curr_road->year;
+            if (decreaseCityKey(workspace, next_city, new_len, new_year)) {
+                City *prev_city = workspace->prev_cities[next_city->id];
+
+                SEARCH_STATS_ADD(decreased, 1);
+                if (prev_city != NULL && prev_city != curr_city) {
+                    SEARCH_STATS_END(SEARCH_END_AMBIGUOUS);
+                    return false;
+                }
+            }
+        }
+
+        curr_city = popCity(workspace);
+        SEARCH_STATS_ADD(pops, 1);
+        if (curr_city == NULL) {
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
+            return false;
+        }
+    }
+    SEARCH_STATS_END(SEARCH_END_TARGET);
+    return true;
+}
+
+/** @brief Finds distances from city to many cities.
+ * Settles cities in order of their distance from @p source and stops when
+ * @p targets_left different targets are settled, so only one search is
+ * needed for all targets.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param map [in]           - pointer to map,
+ * @param source [in]        - pointer to source city,
+ * @param targets_mask [in]  - array indexed by city number, nonzero for
+ *                             targets,
+ * @param targets_left [in]  - number of different targets which can be
+ *                             reached, search stops after settling them,
+ * @param targets [in]       - array of targets,
+ * @param targets_num [in]   - number of targets,
+ * @param distances [out]    - array of @p targets_num distances.
+ * @return Value @p true if distances were found. Value @p false if
+ * allocation error occurred.
+ */
+bool searchDistances(search_workspace_t *workspace, Map *map, City *source,
+                     const unsigned char *targets_mask, size_t targets_left,
+                     City **targets, size_t targets_num,
+                     distance_t *distances) {
+    City *curr_city;
+    unsigned new_len;
+    int new_year;
+
+    if (!beginSearch(workspace, map)) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        return false;
+    }
+    pushCity(workspace, source, 0, INT_MAX);
+
+    while (targets_left > 0 && (curr_city = popCity(workspace)) != NULL) {
+        SEARCH_STATS_ADD(pops, 1);
+        if (targets_mask[curr_city->id] && --targets_left == 0)
+            break;
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
+            City *next_city = getNextCity(curr_city, curr_road);
+
+            new_len = workspace->lengths[curr_city->id] + curr_road->length;
+            new_year = workspace->years[curr_city->id] < curr_road->year
+                       ? workspace->years[curr_city->id] : curr_road->year;
+            if (decreaseCityKey(workspace, next_city, new_len, new_year))
+                SEARCH_STATS_ADD(decreased, 1);
+        }
+    }
+    SEARCH_STATS_END(targets_left == 0 ? SEARCH_END_TARGET
+                                       : SEARCH_END_UNREACHABLE);
+
+    for (size_t i = 0; i < targets_num; i++) {
+        distances[i].reachable =
+                getCityState(workspace, targets[i]) == CITY_SETTLED;
+        distances[i].length = distances[i].reachable
+                              ? workspace->lengths[targets[i]->id] : 0;
+        distances[i].year = distances[i].reachable
+                            ? workspace->years[targets[i]->id] : 0;
+    }
+    return true;
+}
+
+/** @brief Adds reached city to array of reached cities.
+ * Array grows twice when it's full.
+ * @param reached [in,out]   - pointer to array,
+ * @param reached_num [in,out] - number of cities in array,
+ * @param capacity [in,out]  - size of array,
+ * @param city [in]          - pointer to city,
+ * @param length [in]        - length of best path to city.
+ * @return Value @p true if city was added. Value @p false if allocation
+ * error occurred.
+ */
+static bool addReachedCity(reach_t **reached, size_t *reached_num,
+                           size_t *capacity, City *city, unsigned length) {
+    if (*reached_num == *capacity) {
+        size_t new_capacity = *capacity == 0 ? 64 : 2 * *capacity;
+
+        if (!resizeArray((void **) reached, sizeof(reach_t) * new_capacity))
+            return false;
+        *capacity = new_capacity;
+    }
+    (*reached)[*reached_num].name = city->name;
+    (*reached)[*reached_num].length = length;
+    (*reached_num)++;
+    return true;
+}
+
+/** @brief Finds cities reachable from city by path not longer than limit.
+ * Roads leading further than @p max_length aren't relaxed, so cities
+ * outside limit are never queued and work doesn't depend on size of map.
+ * @param workspace [in,out]   - pointer to workspace,
+ * @param map [in]             - pointer to map,
+ * @param source [in]          - pointer to source city,
+ * @param max_length [in]      - maximal length of path,
+ * @param reached [out]        - array of reached cities sorted by length of
+ *                               path, has to be freed by caller,
+ * @param reached_num [out]    - number of reached cities.
+ * @return Value @p true if cities were found. Value @p false if allocation
+ * error occurred.
+ */
+bool searchWithinLength(search_workspace_t *workspace, Map *map, City *source,
+                        unsigned max_length, reach_t **reached,
+                        size_t *reached_num) {
+    City *curr_city;
+    size_t capacity = 0;
+    unsigned curr_len;
+    int new_year;
+
+    *reached = NULL;
+    *reached_num = 0;
+    if (!beginSearch(workspace, map)) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        return false;
+    }
+    pushCity(workspace, source, 0, INT_MAX);
+
+    while ((curr_city = popCity(workspace)) != NULL) {
+        SEARCH_STATS_ADD(pops, 1);
+        SEARCH_STATS_ADD(settled, 1);
+        curr_len = workspace->lengths[curr_city->id];
+        if (!addReachedCity(reached, reached_num, &capacity, curr_city,
+                            curr_len)) {
+            MEMORY_FREE(MEMORY_PATH, *reached);
+            *reached = NULL;
+            *reached_num = 0;
+            SEARCH_STATS_END(SEARCH_END_ERROR);
+            return false;
+        }
+
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
+
+            if (curr_road->length > max_length - curr_len)
+                continue;
+            new_year = workspace->years[curr_city->id] < curr_road->year
+                       ? workspace->years[curr_city->id] : curr_road->year;
+            if (decreaseCityKey(workspace, getNextCity(curr_city, curr_road),
+                                curr_len + curr_road->length, new_year))
+                SEARCH_STATS_ADD(decreased, 1);
+        }
+    }
+    SEARCH_STATS_END(SEARCH_END_TARGET);
+    return true;
+}
+
+/** @brief Finds distances to city which are lower bounds for other searches.
+ * Settles cities in order of their distance from @p target until
+ * @p source is settled. Every city not settled is not closer to
+ * @p target than @p source.
+ * @param bounds [in,out]    - pointer to workspace keeping distances,
+ * @param map [in]           - pointer to map,
+ * @param target [in]        - pointer to target city,
+ * @param source [in]        - pointer to source city,
+ * @param status [out]       - result of search.
+ * @return Distance between cities if @p status is @ref PATH_FOUND.
+ */
+unsigned searchLowerBounds(search_workspace_t *bounds, Map *map, City *target,
+                           City *source, path_status_t *status) {
+    City *curr_city;
+
+    if (!beginSearch(bounds, map)) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        *status = PATH_ERROR;
+        return 0;
+    }
+    pushCity(bounds, target, 0, INT_MAX);
+
+    while ((curr_city = popCity(bounds)) != source) {
+        SEARCH_STATS_ADD(pops, 1);
+        if (curr_city == NULL) {
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
+            *status = PATH_UNREACHABLE;
+            return 0;
+        }
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
+
+            if (decreaseCityKey(bounds, getNextCity(curr_city, curr_road),
+                                bounds->lengths[curr_city->id] +
+                                curr_road->length, INT_MAX))
+                SEARCH_STATS_ADD(decreased, 1);
+        }
+    }
+    SEARCH_STATS_ADD(pops, 1);
+    SEARCH_STATS_END(SEARCH_END_TARGET);
+    *status = PATH_FOUND;
+    return bounds->lengths[source->id];
+}
+
+/** @brief Returns lower bound of distance between city and target.
+ * @param bounds [in]      - pointer to workspace filled by
+ *                           @ref searchLowerBounds,
+ * @param city [in]        - pointer to city,
+ * @param radius [in]      - distance between source and target.
+ * @return Distance to target if city was settled, otherwise @p radius.
+ */
+static inline unsigned getLowerBound(search_workspace_t *bounds, City *city,
+                                     unsigned radius) {
+    if (getCityState(bounds, city) != CITY_SETTLED)
+        return radius;
+    return bounds->lengths[city->id];
+}
+
+/** @brief Checks if road is excluded.
+ * @param road [in]          - pointer to road,
+ * @param roads [in]         - array of excluded roads,
+ * @param roads_num [in]     - number of excluded roads.
+ * @return Value @p true if road is excluded. Otherwise value @p false.
+ */
+static bool checkIfRoadExcluded(Road *road, Road **roads, size_t roads_num) {
+    for (size_t i = 0; i < roads_num; i++) {
+        if (roads[i] == road)
+            return true;
+    }
+    return false;
+}
+
+/** @brief Finds best continuation of path from spur city to target.
+ * Path already goes from source through cities @p root_cities to
+ * @p spur, which has length @p root_len and oldest road from
+ * @p root_year. Cities of that part can't be visited again and roads
+ * @p spur_roads can't be used from @p spur. Search is directed to target
+ * by lower bounds found by @ref searchLowerBounds, so key of city is length
+ * of path to it plus its lower bound. Bounds are consistent, so cities
+ * are settled with best lengths and years like in @ref searchBestPath,
+ * but search visits mostly cities close to best way to target.
+ * @param workspace [in,out]   - pointer to workspace,
+ * @param bounds [in]          - pointer to workspace with lower bounds,
+ * @param radius [in]          - distance between source and target,
+ * @param map [in]             - pointer to map,
+ * @param spur [in]            - pointer to spur city,
+ * @param target [in]          - pointer to target city,
+ * @param root_cities [in]     - array of cities before @p spur,
+ * @param root_num [in]        - number of cities before @p spur,
+ * @param root_len [in]        - length of path to @p spur,
+ * @param root_year [in]       - year of oldest road on path to @p spur,
+ * @param spur_roads [in]      - array of roads excluded from @p spur,
+ * @param spur_roads_num [in]  - number of excluded roads,
+ * @param status [out]         - result of search.
+ * @return Pointer to path from @p spur to target, whose length and year
+ * include part before @p spur, or NULL if path wasn't found.
+ */
+path_t *searchSpurPath(search_workspace_t *workspace,
+                       search_workspace_t *bounds, unsigned radius, Map *map,
+                       City *spur, City *target, City **root_cities,
+                       size_t root_num, unsigned root_len, int root_year,
+                       Road **spur_roads, size_t spur_roads_num,
+                       path_status_t *status) {
+    City *curr_city;
+    path_t *path;
+    unsigned curr_len;
+    int new_year;
+
+    *status = PATH_ERROR;
+    if (!beginSearch(workspace, map)) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        return NULL;
+    }
+    for (size_t i = 0; i < root_num; i++)
+        setCityState(workspace, root_cities[i], CITY_EXCLUDED);
+    pushCity(workspace, spur, root_len + getLowerBound(bounds, spur, radius),
+             root_year);
+
+    while ((curr_city = popCity(workspace)) != target) {
+        SEARCH_STATS_ADD(pops, 1);
+        if (curr_city == NULL) {
+            SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
+            *status = PATH_UNREACHABLE;
+            return NULL;
+        }
+        SEARCH_STATS_ADD(settled, 1);
+        SEARCH_STATS_ADD(relaxed, curr_city->roads_num);
+        curr_len = workspace->lengths[curr_city->id] -
+                   getLowerBound(bounds, curr_city, radius);
+        for (unsigned i = 0; i < curr_city->roads_num; i++) {
+            Road *curr_road = curr_city->roads[i];
+            City *next_city = getNextCity(curr_city, curr_road);
+
+            if (curr_city == spur &&
+                checkIfRoadExcluded(curr_road, spur_roads, spur_roads_num))
+                continue;
+            new_year = workspace->years[curr_city->id] < curr_road->year
+                       ? workspace->years[curr_city->id] : curr_road->year;
+            if (decreaseCityKey(workspace, next_city,
+                                curr_len + curr_road->length +
+                                getLowerBound(bounds, next_city, radius),
+                                new_year)) {
+                SEARCH_STATS_ADD(decreased, 1);
+                workspace->prev_cities[next_city->id] = curr_city;
+            }
+        }
+    }
+    SEARCH_STATS_ADD(pops, 1);
+    SEARCH_STATS_END(SEARCH_END_TARGET);
+
+    path = (path_t *) MEMORY_ALLOC(MEMORY_PATH, sizeof(path_t));
+    if (path == NULL)
+        return NULL;
+    path->total_len = workspace->lengths[target->id];
+    path->year = workspace->years[target->id];
+    path->roads = newList();
+    if (path->roads == NULL) {
+        MEMORY_FREE(MEMORY_PATH, path);
+        return NULL;
+    }
+
+    while (curr_city != spur) {
+        City *prev_city = workspace->prev_cities[curr_city->id];
+        Road *curr_road = getRoadToCity(curr_city, prev_city);
+
+        if (curr_road == NULL || !addList(&path->roads, (void *) curr_road)) {
+            deleteList(&path->roads);
+            MEMORY_FREE(MEMORY_PATH, path);
+            return NULL;
+        }
+        curr_city = prev_city;
+    }
+    *status = PATH_FOUND;
+    return path;
+}
+
+/**
+ * Structure representing label of bi-criteria search, which is path from
+ * source to city.
+ */
+typedef struct label {
+    City *city;                 /**< Last city of path. */
+    Road *road;                 /**< Last road of path, NULL for source. */
+    size_t prev;                /**< Number of label of path without last
+                                     road. */
+    unsigned length;            /**< Length of path. */
+    int year;                   /**< Year of oldest road of path. */
+} label_t;
+
+/**
+ * Structure representing labels of bi-criteria search and heap of labels
+ * which weren't processed.
+ */
+typedef struct label_queue {
+    label_t *labels;            /**< Array of all created labels. */
+    size_t labels_num;          /**< Number of labels. */
+    size_t labels_capacity;     /**< Size of array of labels. */
+    size_t *heap;               /**< Heap of numbers of labels, first node
+                                     has number 1. */
+    size_t heap_size;           /**< Number of labels in heap. */
+} label_queue_t;
+
+/** @brief Checks if first label is processed before second.
+ * Labels are ordered by length, then by year descending, then by number.
+ * @param queue [in]       - pointer to queue,
+ * @param label1 [in]      - number of first label,
+ * @param label2 [in]      - number of second label.
+ * @return Value @p true if first label goes first. Otherwise value
+ * @p false.
+ */
+static inline bool checkIfFirstLabelBetter(label_queue_t *queue,
+                                           size_t label1, size_t label2) {
+    label_t *first = &queue->labels[label1], *second = &queue->labels[label2];
+
+    if (first->length != second->length)
+        return first->length < second->length;
+    if (first->year != second->year)
+        return first->year > second->year;
+    return label1 < label2;
+}
+
+/** @brief Adds label to queue.
+ * Heap has the same capacity as array of labels.
+ * @param queue [in,out]   - pointer to queue,
+ * @param city [in]        - pointer to last city of path,
+ * @param road [in]        - pointer to last road of path,
+ * @param prev [in]        - number of previous label,
+ * @param length [in]      - length of path,
+ * @param year [in]        - year of oldest road of path.
+ * @return Value @p true if label was added. Value @p false if allocation
+ * error occurred.
+ */
+static bool pushLabel(label_queue_t *queue, City *city, Road *road,
+                      size_t prev, unsigned length, int year) {
+    size_t node;
+
+    if (queue->labels_num == queue->labels_capacity) {
+        size_t new_capacity = queue->labels_capacity == 0
+                              ? 64 : 2 * queue->labels_capacity;
+
+        if (!resizeArray((void **) &queue->labels,
+                         sizeof(label_t) * new_capacity) ||
+            !resizeArray((void **) &queue->heap,
+                         sizeof(size_t) * (new_capacity + 1)))
+            return false;
+        queue->labels_capacity = new_capacity;
+    }
+    queue->labels[queue->labels_num] = (label_t) {city, road, prev, length,
+                                                  year};
+
+    node = ++queue->heap_size;
+    while (node > 1 && checkIfFirstLabelBetter(queue, queue->labels_num,
+                                               queue->heap[node / 2])) {
+        queue->heap[node] = queue->heap[node / 2];
+        node /= 2;
+    }
+    queue->heap[node] = queue->labels_num++;
+    SEARCH_STATS_ADD(pushes, 1);
+    return true;
+}
+
+/** @brief Removes first label from queue.
+ * @param queue [in,out]   - pointer to non-empty queue.
+ * @return Number of removed label.
+ */
+static size_t popLabel(label_queue_t *queue) {
+    size_t first = queue->heap[1];
+    size_t last = queue->heap[queue->heap_size--];
+    size_t node = 1, child;
+
+    while ((child = 2 * node) <= queue->heap_size) {
+        if (child < queue->heap_size &&
+            checkIfFirstLabelBetter(queue, queue->heap[child + 1],
+                                    queue->heap[child]))
+            child++;
+        if (!checkIfFirstLabelBetter(queue, queue->heap[child], last))
+            break;
+        queue->heap[node] = queue->heap[child];
+        node = child;
+    }
+    queue->heap[node] = last;
+    return first;
+}
+
+/** @brief Checks if path to city is dominated by processed path.
+ * Processed paths aren't longer, so path is dominated if city was already
+ * reached by path with oldest road not older. Path is also dominated if
+ * target was reached that way, because extending path can't make it
+ * shorter or its oldest road younger.
+ * @param workspace [in]   - pointer to workspace,
+ * @param city [in]        - pointer to city,
+ * @param target [in]      - pointer to target city,
+ * @param year [in]        - year of oldest road of path.
+ * @return Value @p true if path is dominated. Otherwise value @p false.
+ */
+static inline bool checkIfLabelDominated(search_workspace_t *workspace,
+                                         City *city, City *target, int year) {
+    return (getCityState(workspace, city) == CITY_SETTLED &&
+            workspace->years[city->id] >= year) ||
+           (getCityState(workspace, target) == CITY_SETTLED &&
+            workspace->years[target->id] >= year);
+}
+
+/** @brief Creates path described by label.
+ * @param queue [in]       - pointer to queue,
+ * @param label [in]       - number of last label of path.
+ * @return Pointer to path or NULL if allocation error occurred.
+ */
+static path_t *createPathFromLabel(label_queue_t *queue, size_t label) {
+    path_t *path = (path_t *) MEMORY_ALLOC(MEMORY_PATH, sizeof(path_t));
+
+    if (path == NULL)
+        return NULL;
+    path->total_len = queue->labels[label].length;
+    path->year = queue->labels[label].year;
+    path->roads = newList();
+    if (path->roads == NULL) {
+        MEMORY_FREE(MEMORY_PATH, path);
+        return NULL;
+    }
+
+    while (queue->labels[label].road != NULL) {
+        if (!addList(&path->roads, (void *) queue->labels[label].road)) {
+            deleteList(&path->roads);
+            MEMORY_FREE(MEMORY_PATH, path);
+            return NULL;
+        }
+        label = queue->labels[label].prev;
+    }
+    return path;
+}
+
+/** @brief Finds Pareto optimal paths between two cities.
+ * Path is Pareto optimal if no other path is not longer and has oldest road
+ * not older, and one of them strictly. Labels are processed in order of
+ * length and then year descending, so label is final if it isn't dominated
+ * when it leaves queue. Processed labels of city have growing years, so only
+ * year of last one is kept in workspace and checking dominance takes
+ * constant time. Dominated labels aren't extended, so paths never visit
+ * city twice.
+ * @param workspace [in,out] - pointer to workspace,
+ * @param map [in]           - pointer to map,
+ * @param city1 [in]         - pointer to first city,
+ * @param city2 [in]         - pointer to last city,
+ * @param paths_num [out]    - number of found paths,
+ * @param status [out]       - result of search.
+ * @return Array of paths sorted by length, which has to be deleted by
+ * @ref deletePaths, or NULL if paths weren't found.
+ */
+path_t **searchParetoPaths(search_workspace_t *workspace, Map *map,
+                           City *city1, City *city2, size_t *paths_num,
+                           path_status_t *status) {
+    label_queue_t queue = {NULL, 0, 0, NULL, 0};
+    size_t *found = NULL, found_num = 0, found_capacity = 0;
+    path_t **paths = NULL;
+    bool failed;
+    label_t curr;
+    size_t label;
+
+    *paths_num = 0;
+    failed = !beginSearch(workspace, map) ||
+             !pushLabel(&queue, city1, NULL, 0, 0, INT_MAX);
+
+    while (!failed && queue.heap_size > 0) {
+        label = popLabel(&queue);
+        curr = queue.labels[label];
+        SEARCH_STATS_ADD(pops, 1);
+        if (checkIfLabelDominated(workspace, curr.city, city2, curr.year))
+            continue;
+        SEARCH_STATS_ADD(settled, 1);
+        setCityState(workspace, curr.city, CITY_SETTLED);
+        workspace->years[curr.city->id] = curr.year;
+
+        if (curr.city == city2) {
+            if (found_num == found_capacity) {
+                found_capacity = found_capacity == 0 ? 16 : 2 * found_capacity;
+                failed = !resizeArray((void **) &found,
+                                      sizeof(size_t) * found_capacity);
+            }
+            if (!failed)
+                found[found_num++] = label;
+            continue;
+        }
+
+        SEARCH_STATS_ADD(relaxed, curr.city->roads_num);
+        for (unsigned i = 0; i < curr.city->roads_num && !failed; i++) {
+            Road *curr_road = curr.city->roads[i];
+            City *next_city = getNextCity(curr.city, curr_road);
+            int new_year = curr.year < curr_road->year ? curr.year
+                                                       : curr_road->year;
+
+            if (checkIfLabelDominated(workspace, next_city, city2, new_year))
+                continue;
+            failed = !pushLabel(&queue, next_city, curr_road, label,
+                                curr.length + curr_road->length, new_year);
+            SEARCH_STATS_ADD(decreased, 1);
+        }
+    }
+
+    if (!failed && found_num > 0) {
+        paths = (path_t **) MEMORY_ALLOC(MEMORY_PATH,
+                                         sizeof(path_t *) * found_num);
+        failed = paths == NULL;
+        for (size_t i = 0; !failed && i < found_num; i++) {
+            paths[i] = createPathFromLabel(&queue, found[i]);
+            if (paths[i] == NULL) {
+                deletePaths(paths, i);
+                paths = NULL;
+                failed = true;
+            }
+        }
+    }
+
+    if (failed) {
+        SEARCH_STATS_END(SEARCH_END_ERROR);
+        *status = PATH_ERROR;
+    } else if (found_num == 0) {
+        SEARCH_STATS_END(SEARCH_END_UNREACHABLE);
+        *status = PATH_UNREACHABLE;
+    } else {
+        SEARCH_STATS_END(SEARCH_END_TARGET);
+        *status = PATH_FOUND;
+        *paths_num = found_num;
+    }
+
+    MEMORY_FREE(MEMORY_PATH, found);
+    MEMORY_FREE(MEMORY_PATH, queue.labels);
+    MEMORY_FREE(MEMORY_PATH, queue.heap);
+    return paths;
+}
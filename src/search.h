@@ -0,0 +1,52 @@
+/** @file
+ * Interface of module finding best path using reusable workspace.
+ * Module gives the same results as module path, but keeps state of search
+ * in workspace instead of cities, so searches don't depend on number of
+ * cities in map and searches in different workspaces can run concurrently.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_SEARCH_H
+#define ROADS_SEARCH_H
+
+#include "roads_types.h"
+
+search_workspace_t *createSearchWorkspace();
+
+void deleteSearchWorkspace(search_workspace_t *workspace);
+
+path_t *searchBestPath(search_workspace_t *workspace, Map *map, City *city1,
+                       City *city2, list_t **exclude_roads, bool direct,
+                       int min_year, path_status_t *status);
+
+bool searchIfPathDefinedUnambiguously(search_workspace_t *workspace, Map *map,
+                                      path_t *path, City *city1, City *city2,
+                                      list_t **exclude_roads, bool direct,
+                                      int min_year);
+
+bool searchDistances(search_workspace_t *workspace, Map *map, City *source,
+                     const unsigned char *targets_mask, size_t targets_left,
+                     City **targets, size_t targets_num,
+                     distance_t *distances);
+
+bool searchWithinLength(search_workspace_t *workspace, Map *map, City *source,
+                        unsigned max_length, reach_t **reached,
+                        size_t *reached_num);
+
+unsigned searchLowerBounds(search_workspace_t *bounds, Map *map, City *target,
+                           City *source, path_status_t *status);
+
+path_t *searchSpurPath(search_workspace_t *workspace,
+                       search_workspace_t *bounds, unsigned radius, Map *map,
+                       City *spur, City *target, City **root_cities,
+                       size_t root_num, unsigned root_len, int root_year,
+                       Road **spur_roads, size_t spur_roads_num,
+                       path_status_t *status);
+
+path_t **searchParetoPaths(search_workspace_t *workspace, Map *map,
+                           City *city1, City *city2, size_t *paths_num,
+                           path_status_t *status);
+
+#endif //ROADS_SEARCH_H
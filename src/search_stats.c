@@ -0,0 +1,42 @@
+/** @file
+ * Implementation of path search instrumentation.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <string.h>
+
+#include "search_stats.h"
+
+#ifdef ROADS_SEARCH_STATS
+_Thread_local search_stats_t search_stats;
+#endif
+
+/** @brief Clears statistics.
+ * @param stats [out]      - pointer to statistics.
+ */
+void resetSearchStats(search_stats_t *stats) {
+    memset(stats, 0, sizeof(search_stats_t));
+}
+
+/** @brief Adds other statistics to statistics.
+ * @param stats [in,out]   - pointer to statistics,
+ * @param other [in]       - pointer to added statistics.
+ */
+void addSearchStats(search_stats_t *stats, const search_stats_t *other) {
+    stats->searches += other->searches;
+    stats->settled += other->settled;
+    stats->relaxed += other->relaxed;
+    stats->decreased += other->decreased;
+    stats->pops += other->pops;
+    stats->heap_init += other->heap_init;
+    stats->pushes += other->pushes;
+    stats->routes += other->routes;
+    stats->bridge_scans += other->bridge_scans;
+    stats->bridge_rejects += other->bridge_rejects;
+    stats->component_builds += other->component_builds;
+    stats->component_rejects += other->component_rejects;
+    for (int i = 0; i < SEARCH_ENDS_NUM; i++)
+        stats->ends[i] += other->ends[i];
+}
@@ -0,0 +1,76 @@
+/** @file
+ * Interface of path search instrumentation.
+ * Path searches count their work in thread local statistics. Counting is
+ * compiled in only if macro ROADS_SEARCH_STATS is defined, otherwise
+ * counting macros do nothing.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_SEARCH_STATS_H
+#define ROADS_SEARCH_STATS_H
+
+#include <stdint.h>
+
+/**
+ * Reason of ending path search.
+ */
+typedef enum search_end {
+    SEARCH_END_TARGET,          /**< Target city was reached. */
+    SEARCH_END_UNREACHABLE,     /**< Target city isn't reachable. */
+    SEARCH_END_AMBIGUOUS,       /**< Path was found ambiguous. */
+    SEARCH_END_ERROR,           /**< Allocation error occurred. */
+    SEARCH_ENDS_NUM             /**< Number of reasons. */
+} search_end_t;
+
+/**
+ * Structure representing work done by path searches.
+ */
+typedef struct search_stats {
+    uint64_t searches;          /**< Number of searches. */
+    uint64_t settled;           /**< Number of settled cities. */
+    uint64_t relaxed;           /**< Number of relaxed roads. */
+    uint64_t decreased;         /**< Number of successful decrease-key
+                                     operations. */
+    uint64_t pops;              /**< Number of heap pops. */
+    uint64_t heap_init;         /**< Sum of heap sizes at start of search. */
+    uint64_t pushes;            /**< Number of cities added to heap. */
+    uint64_t routes;            /**< Number of routes for which diversion
+                                     was searched. */
+    uint64_t bridge_scans;      /**< Number of searches for bridges. */
+    uint64_t bridge_rejects;    /**< Number of road removals rejected
+                                     because road is bridge. */
+    uint64_t component_builds;  /**< Number of builds of index of connected
+                                     components. */
+    uint64_t component_rejects; /**< Number of requests rejected because
+                                     cities are in different components. */
+    uint64_t ends[SEARCH_ENDS_NUM]; /**< Number of searches ended for every
+                                         reason. */
+} search_stats_t;
+
+#ifdef ROADS_SEARCH_STATS
+/**
+ * Statistics of searches done by current thread.
+ */
+extern _Thread_local search_stats_t search_stats;
+
+/**
+ * Macro adding @p value to field of statistics of current thread.
+ */
+#define SEARCH_STATS_ADD(field, value) (search_stats.field += (value))
+/**
+ * Macro recording end of search with given reason.
+ */
+#define SEARCH_STATS_END(reason) \
+    (search_stats.searches++, search_stats.ends[reason]++)
+#else
+#define SEARCH_STATS_ADD(field, value) ((void) 0)
+#define SEARCH_STATS_END(reason) ((void) 0)
+#endif
+
+void resetSearchStats(search_stats_t *stats);
+
+void addSearchStats(search_stats_t *stats, const search_stats_t *other);
+
+#endif //ROADS_SEARCH_STATS_H
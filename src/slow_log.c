@@ -0,0 +1,79 @@
+/** @file
+ * Implementation of log of slow commands.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "slow_log.h"
+
+/** @brief Creates log of slow commands.
+ * @param path [in]        - path of log file,
+ * @param threshold [in]   - minimal logged execution time in nanoseconds.
+ * @return Pointer to log or NULL if file can't be opened or allocation
+ * error occurred.
+ */
+slow_log_t *createSlowLog(const char *path, uint64_t threshold) {
+    slow_log_t *log = (slow_log_t *) malloc(sizeof(slow_log_t));
+
+    if (log == NULL)
+        return NULL;
+
+    log->file = fopen(path, "w");
+    if (log->file == NULL) {
+        free(log);
+        return NULL;
+    }
+    log->threshold = threshold;
+    log->head = 0;
+    log->entries_num = 0;
+    return log;
+}
+
+/** @brief Writes all entries and deletes log.
+ * @param log [in,out]     - pointer to log.
+ */
+void deleteSlowLog(slow_log_t *log) {
+    if (log == NULL)
+        return;
+
+    flushSlowLog(log);
+    fclose(log->file);
+    free(log);
+}
+
+/** @brief Gets next free entry of ring buffer.
+ * If buffer is full, entries are written to file first. Entry has to be
+ * filled by caller.
+ * @param log [in,out]     - pointer to log.
+ * @return Pointer to entry.
+ */
+slow_entry_t *addSlowLogEntry(slow_log_t *log) {
+    if (log->entries_num == SLOW_LOG_ENTRIES)
+        flushSlowLog(log);
+
+    return &log->entries[(log->head + log->entries_num++) % SLOW_LOG_ENTRIES];
+}
+
+/** @brief Writes all entries to file.
+ * Every entry is line with line number, execution time in nanoseconds,
+ * result, number of path searches and affected routes and command text.
+ * @param log [in,out]     - pointer to log.
+ */
+void flushSlowLog(slow_log_t *log) {
+    while (log->entries_num > 0) {
+        slow_entry_t *entry = &log->entries[log->head];
+
+        fprintf(log->file, "line=%d time=%" PRIu64 " result=%s searches=%"
+                PRIu64 " routes=%" PRIu64 " text=%s%s\n", entry->line_number,
+                entry->duration, entry->ok ? "ok" : "error", entry->searches,
+                entry->routes, entry->text,
+                entry->text_len >= SLOW_LOG_TEXT_LENGTH ? "..." : "");
+        log->head = (log->head + 1) % SLOW_LOG_ENTRIES;
+        log->entries_num--;
+    }
+    fflush(log->file);
+}
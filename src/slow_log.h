@@ -0,0 +1,60 @@
+/** @file
+ * Interface of log of slow commands.
+ * Commands executed longer than threshold are stored in preallocated ring
+ * buffer, which is written to file when it's full, on flush and on delete.
+ *
+ * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
+ * @date 18.10.2026
+ */
+
+#ifndef ROADS_SLOW_LOG_H
+#define ROADS_SLOW_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Macro defining number of entries of ring buffer.
+ */
+#define SLOW_LOG_ENTRIES 256
+/**
+ * Macro defining maximal stored length of command text. Longer texts are
+ * truncated.
+ */
+#define SLOW_LOG_TEXT_LENGTH 1024
+
+/**
+ * Structure representing logged command.
+ */
+typedef struct slow_entry {
+    int line_number;            /**< Number of line in input. */
+    bool ok;                    /**< Flag indicating if command succeeded. */
+    uint64_t duration;          /**< Execution time in nanoseconds. */
+    uint64_t searches;          /**< Number of path searches. */
+    uint64_t routes;            /**< Number of routes affected by command. */
+    size_t text_len;            /**< Length of whole command text. */
+    char text[SLOW_LOG_TEXT_LENGTH];    /**< Command text. */
+} slow_entry_t;
+
+/**
+ * Structure representing log of slow commands.
+ */
+typedef struct slow_log {
+    FILE *file;                 /**< Log file. */
+    uint64_t threshold;         /**< Minimal logged execution time
+                                     in nanoseconds. */
+    size_t head;                /**< Index of oldest not written entry. */
+    size_t entries_num;         /**< Number of not written entries. */
+    slow_entry_t entries[SLOW_LOG_ENTRIES];     /**< Ring buffer. */
+} slow_log_t;
+
+slow_log_t *createSlowLog(const char *path, uint64_t threshold);
+
+void deleteSlowLog(slow_log_t *log);
+
+slow_entry_t *addSlowLogEntry(slow_log_t *log);
+
+void flushSlowLog(slow_log_t *log);
+
+#endif //ROADS_SLOW_LOG_H
@@ -1,17 +1,33 @@
 /** @file
  * Implementation of text interface.
+ * Input is processed by two threads connected by lock-free queue
+ * of commands. Parser thread reads and parses lines and hands them over
+ * in chunks, main thread executes parsed commands in input order. In replay
+ * mode commands are read from file loaded to memory and executed in one
+ * thread without printing results, so parsing and execution can be measured
+ * separately.
  *
  * @author Piotr Jasinski <jasinskipiotr99@gmail.com>
  * @date 21.07.2020
  */
 
+#include <limits.h>
+#include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "text_interface.h"
+#include "command.h"
+#include "command_queue.h"
+#include "command_stats.h"
 #include "map.h"
+#include "memory_stats.h"
+#include "output.h"
+#include "slow_log.h"
 #include "utils.h"
 
 /**
@@ -26,363 +42,1098 @@
  * Macro defining critical error like lack ot memory etc.
  */
 #define CRITICAL_ERROR 2
+/**
+ * Macro defining number of commands in queue between parser and executor.
+ */
+#define QUEUE_CAPACITY 4096
+/**
+ * Macro defining maximal number of parsed lines published to executor
+ * at once.
+ */
+#define PARSER_CHUNK_SIZE 64
+/**
+ * Macro defining size of block read from input at once.
+ */
+#define READ_BUFFER_SIZE 65536
 
-/** @brief Executes @ref createRoute.
- * Converts route description in format like in @ref getRouteDescription to
- * road descriptions acceptable by @ref createRoute.
- * Checks if new route makes path.
- * Assumes that routeId; was already removed from description and rest
- * of description is available through strtok function.
- * @param map [in,out] - double pointer to map,
- * @param routeId [in] - route number.
- * @return Value @ref SUCCESS, @ref ERROR depending on function result.
- * Value @ref CRITICAL_ERROR if allocation error occurred.
- */
-static int executeCreateRoute(Map **map, unsigned routeId) {
-    char *road_params[4] = {NULL, NULL, NULL, NULL};
-    char *road;
-    int curr_param = 0;
-    bool str = false;
-    list_t *road_desc = newList();
-    map_t *cities_name = mapInit(cityNameCmp, cityNameEq, printCityName, free,
-                                 free);
-
-    if (road_desc == NULL || cities_name == NULL) {
-        deleteList(&road_desc);
-        mapDelete(cities_name, 0);
-        return CRITICAL_ERROR;
-    }
+/**
+ * Maximal length of distance printed by distanceMatrix command, two
+ * semicolons, length and year.
+ */
+#define DISTANCE_TEXT_LENGTH 24
 
-    while ((road_params[curr_param] = strtok(NULL, ";")) != NULL) {
-        if (curr_param == 0) {
-            if (!mapInsert(cities_name, (void *) road_params[0], "")) {
-                deleteList(&road_desc);
-                mapDelete(cities_name, 0);
-                return CRITICAL_ERROR;
-            }
-        }
-        if (curr_param == 3) {
-            str = true;
-            unsigned long long road_desc_len = 0;
-            if (mapContains(cities_name, (void *) road_params[3])) {
-                while (!emptyList(&road_desc))
-                    free(removeHeadList(&road_desc));
-                deleteList(&road_desc);
-                mapDelete(cities_name, 0);
-                return ERROR;
-            } else {
-                if (!mapInsert(cities_name, (void *) road_params[3], "")) {
-                    while (!emptyList(&road_desc))
-                        free(removeHeadList(&road_desc));
-                    deleteList(&road_desc);
-                    mapDelete(cities_name, 0);
-                    return CRITICAL_ERROR;
-                }
-            }
-            for (int i = 0; i < 4; i++) {
-                road_desc_len += strlen(road_params[i]);
-                road_desc_len++;
-            }
-            road = malloc(sizeof(char) * road_desc_len);
-            if (road == NULL) {
-                while (!emptyList(&road_desc))
-                    free(removeHeadList(&road_desc));
-                deleteList(&road_desc);
-                mapDelete(cities_name, 0);
-                return CRITICAL_ERROR;
-            }
-            road_desc_len = 0;
-            for (int i = 0; i < 4; i++) {
-                strcpy(road + road_desc_len, road_params[i]);
-                road_desc_len = strlen(road);
-                if (i == 3)
-                    road[road_desc_len] = '\0';
-                else
-                    road[road_desc_len] = ';';
-                road_desc_len++;
-            }
-            if (!addList(&road_desc, (void *) road)) {
-                free(road);
-                while (!emptyList(&road_desc))
-                    free(removeHeadList(&road_desc));
-                deleteList(&road_desc);
-                mapDelete(cities_name, 0);
-                return CRITICAL_ERROR;
-            }
-            road_params[0] = road_params[3];
-            curr_param = 1;
-        } else {
-            curr_param++;
+/**
+ * Structure describing road line read inside bulk load block.
+ * City names are stored as offsets in text buffer of block.
+ */
+typedef struct bulk_line {
+    int line_number;        /**< Number of line in input. */
+    bool valid;             /**< Flag indicating if line has valid format. */
+    size_t city1;           /**< Offset of first city name. */
+    size_t city2;           /**< Offset of second city name. */
+    unsigned length;        /**< Length of road. */
+    int year;               /**< Built year. */
+} bulk_line_t;
+
+/**
+ * Structure storing roads read between beginBulkLoad and endBulkLoad commands.
+ */
+typedef struct bulk_load {
+    bool active;            /**< Flag indicating if block is being read. */
+    char *text;             /**< Copied city names. */
+    size_t text_len;        /**< Number of used bytes of text buffer. */
+    size_t text_capacity;   /**< Size of text buffer. */
+    bulk_line_t *lines;     /**< Array of read lines. */
+    size_t lines_num;       /**< Number of read lines. */
+    size_t lines_capacity;  /**< Size of array of lines. */
+} bulk_load_t;
+
+/**
+ * Structure representing reader splitting input into lines.
+ */
+typedef struct line_reader {
+    int fd;                 /**< Input file descriptor. */
+    char *buffer;           /**< Block of input. */
+    size_t pos;             /**< Position of first not consumed byte. */
+    size_t len;             /**< Number of bytes in buffer. */
+} line_reader_t;
+
+/**
+ * Structure containing arguments of parser thread.
+ */
+typedef struct parser_args {
+    command_queue_t *queue; /**< Pointer to queue of commands. */
+    line_reader_t *reader;  /**< Pointer to input reader. */
+} parser_args_t;
+
+/**
+ * Structure representing state of executor.
+ */
+typedef struct interface {
+    Map *map;                   /**< Pointer to map. */
+    bulk_load_t bulk;           /**< Bulk load block. */
+    command_stats_t *stats;     /**< Statistics of executed commands. */
+    slow_log_t *slow_log;       /**< Log of slow commands or NULL. */
+    FILE *stats_file;           /**< File with periodic statistics or NULL. */
+    uint64_t stats_interval;    /**< Interval of statistics dumps
+                                     in nanoseconds. */
+    uint64_t start_time;        /**< Time of start of interface. */
+    uint64_t next_dump;         /**< Time of next statistics dump. */
+    int lines_num;              /**< Number of executed lines. */
+} interface_t;
+
+/**
+ * Structure representing times of one replay.
+ */
+typedef struct replay_time {
+    uint64_t total;             /**< Time of whole replay in nanoseconds. */
+    uint64_t parse;             /**< Time of reading and parsing lines
+                                     in nanoseconds. */
+    uint64_t engine;            /**< Time of execution of commands
+                                     in nanoseconds. */
+} replay_time_t;
+
+/** @brief Reads next line of input into command text.
+ * Line contains '\n' if it was present in input, like line read by getline.
+ * Input is read in large blocks, but read returns as soon as any data is
+ * available, so interactive input isn't delayed.
+ * @param reader [in,out]  - pointer to reader,
+ * @param command [in,out] - pointer to command.
+ * @return Value @p 1 if line was read, @p 0 at end of input, @p -1 if
+ * allocation error occurred.
+ */
+static int readLine(line_reader_t *reader, command_t *command) {
+    command->text_len = 0;
+    if (!appendCommandText(command, "", 0))
+        return -1;
+
+    while (true) {
+        if (reader->pos == reader->len) {
+            ssize_t read_len = read(reader->fd, reader->buffer,
+                                    READ_BUFFER_SIZE);
+            if (read_len <= 0)
+                return command->text_len > 0 ? 1 : 0;
+            reader->pos = 0;
+            reader->len = (size_t) read_len;
         }
+
+        char *begin = reader->buffer + reader->pos;
+        char *end = memchr(begin, '\n', reader->len - reader->pos);
+        size_t len = end == NULL ? reader->len - reader->pos
+                                 : (size_t) (end - begin) + 1;
+
+        if (!appendCommandText(command, begin, len))
+            return -1;
+        reader->pos += len;
+        if (end != NULL)
+            return 1;
     }
+}
 
-    if (curr_param == 1 && str) {
-        mapDelete(cities_name, 0);
-        if (createRoute(map, routeId, road_desc)) {
-            return SUCCESS;
+/** @brief Checks if next line can be read without reading input.
+ * @param reader [in]      - pointer to reader.
+ * @return Value @p true if buffer contains whole next line.
+ */
+static bool hasBufferedLine(const line_reader_t *reader) {
+    return memchr(reader->buffer + reader->pos, '\n',
+                  reader->len - reader->pos) != NULL;
+}
+
+/** @brief Reads and parses lines until end of input.
+ * Body of parser thread. Every line is parsed into next slot of queue.
+ * Parsed lines are published in chunks, so executor and parser don't
+ * exchange positions in queue after every line. Chunk is published early
+ * if next line isn't in buffer yet, so lines aren't delayed while parser
+ * waits for input.
+ * @param arg [in,out]     - pointer to @ref parser_args_t.
+ * @return Value NULL.
+ */
+static void *runParser(void *arg) {
+    parser_args_t *args = (parser_args_t *) arg;
+    command_t *command;
+    bool bulk_active = false;
+    int line_number = 0;
+    int result;
+    size_t chunk_len = 0;
+
+    while ((command = reserveCommand(args->queue)) != NULL) {
+        result = readLine(args->reader, command);
+        if (result == 1) {
+            command->line_number = ++line_number;
+            parseCommand(command, &bulk_active);
         } else {
-            return ERROR;
+            command->type = result == 0 ? COMMAND_END_OF_INPUT
+                                        : COMMAND_CRITICAL_ERROR;
+        }
+
+        if (result != 1) {
+            publishCommands(args->queue);
+            break;
+        }
+        if (++chunk_len == PARSER_CHUNK_SIZE ||
+            !hasBufferedLine(args->reader)) {
+            publishCommands(args->queue);
+            chunk_len = 0;
         }
-    } else {
-        while (!emptyList(&road_desc))
-            free(removeHeadList(&road_desc));
-        deleteList(&road_desc);
-        mapDelete(cities_name, 0);
-        return ERROR;
     }
+    return NULL;
 }
 
-/** @brief Executes @ref addRoad.
- * Assumes that description city1;city2;length;year is available
- * through strtok function.
- * @param map [in,out] - double pointer to map.
+/** @brief Executes @ref getRouteDescription.
+ * Prints description if route number is valid.
+ * @param map [in,out] - double pointer to map,
+ * @param route [in]   - route number.
  * @return Value @ref SUCCESS or @ref ERROR depending on function result.
  */
-static int executeAddRoad(Map **map) {
-    char *args[4];
-    int year;
-    unsigned length;
-
-    for (int i = 0; i < 4; i++) {
-        args[i] = strtok(NULL, ";");
-        if (args[i] == NULL)
-            return ERROR;
-    }
+static int executeGetRouteDescription(Map **map, unsigned route) {
+    const char *desc = getRouteDescription(*map, route);
 
-    length = parseStringToUnsigned(args[2]);
-    year = parseStringToInt(args[3]);
-
-    if (strtok(NULL, ";") != NULL)
-        return ERROR;
-    if (addRoad(*map, args[0], args[1], length, year)) {
+    if (desc != NULL) {
+        outputLine(desc);
+        MEMORY_FREE(MEMORY_ROUTE, (void *) desc);
         return SUCCESS;
     } else {
         return ERROR;
     }
 }
 
-/** @brief Executes @ref repairRoad.
- * Assumes that description city1;city2;year is available through strtok function.
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS or @ref ERROR depending on function result.
+/** @brief Prints descriptions of roads found by query.
+ * Used by @ref executeOldestRoads and @ref executeRouteOldestRoad.
+ * @param desc [in]    - pointer to descriptions or NULL.
+ * @return Value @ref SUCCESS if descriptions were created. Otherwise value
+ * @ref ERROR.
+ */
+static int outputRoads(const char *desc) {
+    if (desc == NULL)
+        return ERROR;
+
+    outputLine(desc);
+    MEMORY_FREE(MEMORY_ROAD, (void *) desc);
+    return SUCCESS;
+}
+
+/** @brief Executes oldestRoads command.
+ * Prints oldest roads, one per line in format of parameters of addRoad.
+ * @param map [in,out] - double pointer to map,
+ * @param k [in]       - maximal number of roads.
+ * @return Value @ref SUCCESS if number of roads is valid. Otherwise value
+ * @ref ERROR.
  */
-static int executeRepairRoad(Map **map) {
-    char *args[3];
-    int year;
+static int executeOldestRoads(Map **map, unsigned k) {
+    return outputRoads(getOldestRoads(*map, k));
+}
 
-    for (int i = 0; i < 3; i++) {
-        args[i] = strtok(NULL, ";");
-        if (args[i] == NULL)
+/** @brief Executes roadsOlderThan command.
+ * Prints number of roads built or repaired last time before given year.
+ * @param map [in,out] - double pointer to map,
+ * @param year [in]    - year.
+ * @return Value @ref SUCCESS if year is valid. Otherwise value @ref ERROR.
+ */
+static int executeRoadsOlderThan(Map **map, int year) {
+    size_t count;
+    char text[24];
+
+    if (!countRoadsOlderThan(*map, year, &count))
+        return ERROR;
+
+    sprintf(text, "%zu", count);
+    outputLine(text);
+    return SUCCESS;
+}
+
+/** @brief Executes routeOldestRoad command.
+ * Prints oldest road of route in format of parameters of addRoad, or empty
+ * line if route doesn't exist.
+ * @param map [in,out] - double pointer to map,
+ * @param route [in]   - route number.
+ * @return Value @ref SUCCESS if route number is valid. Otherwise value
+ * @ref ERROR.
+ */
+static int executeRouteOldestRoad(Map **map, unsigned route) {
+    return outputRoads(getOldestRouteRoad(*map, route));
+}
+
+/** @brief Prints descriptions of paths found by query.
+ * Prints descriptions, or line @p unreachable if cities aren't connected,
+ * or line @p ambiguous if path isn't defined unambiguously.
+ * @param desc [in]    - pointer to descriptions or NULL,
+ * @param status [in]  - result of query.
+ * @return Value @ref SUCCESS if paths were found, cities aren't connected
+ * or path is ambiguous. Otherwise value @ref ERROR.
+ */
+static int outputPaths(const char *desc, path_status_t status) {
+    switch (status) {
+        case PATH_FOUND:
+            outputLine(desc);
+            MEMORY_FREE(MEMORY_PATH, (void *) desc);
+            return SUCCESS;
+        case PATH_UNREACHABLE:
+            outputLine("unreachable");
+            return SUCCESS;
+        case PATH_AMBIGUOUS:
+            outputLine("ambiguous");
+            return SUCCESS;
+        default:
             return ERROR;
     }
+}
 
-    year = parseStringToInt(args[2]);
+/** @brief Executes analyzeRemoveRoad command.
+ * Prints whether road would be removed and diversion of every route
+ * containing road, without changing map.
+ * @param map [in,out] - double pointer to map,
+ * @param city1 [in]   - pointer to name of first city,
+ * @param city2 [in]   - pointer to name of second city.
+ * @return Value @ref SUCCESS if road exists. Otherwise value @ref ERROR.
+ */
+static int executeAnalyzeRemoveRoad(Map **map, const char *city1,
+                                    const char *city2) {
+    const char *desc = analyzeRemoveRoad(*map, city1, city2);
 
-    if (strtok(NULL, ";") != NULL)
+    if (desc == NULL)
         return ERROR;
-    if (repairRoad(*map, args[0], args[1], year)) {
-        return SUCCESS;
-    } else {
+
+    outputLine(desc);
+    MEMORY_FREE(MEMORY_PATH, (void *) desc);
+    return SUCCESS;
+}
+
+/** @brief Executes shortestPath command.
+ * Prints description of path, or line @p unreachable or @p ambiguous if
+ * path wasn't found.
+ * @param map [in,out] - double pointer to map,
+ * @param city1 [in]   - pointer to name of first city,
+ * @param city2 [in]   - pointer to name of second city.
+ * @return Value @ref SUCCESS if path was found, cities aren't connected or
+ * path is ambiguous. Otherwise value @ref ERROR.
+ */
+static int executeShortestPath(Map **map, const char *city1,
+                               const char *city2) {
+    path_status_t status;
+    const char *desc = findShortestPath(*map, city1, city2, &status);
+
+    return outputPaths(desc, status);
+}
+
+/** @brief Executes shortestPathSince command.
+ * Works like @ref executeShortestPath, but path uses only roads built or
+ * repaired in given year or later.
+ * @param map [in,out] - double pointer to map,
+ * @param city1 [in]   - pointer to name of first city,
+ * @param city2 [in]   - pointer to name of second city,
+ * @param year [in]    - oldest year of road which can be used.
+ * @return Value @ref SUCCESS if path was found, cities aren't connected or
+ * path is ambiguous. Otherwise value @ref ERROR.
+ */
+static int executeShortestPathSince(Map **map, const char *city1,
+                                    const char *city2, int year) {
+    path_status_t status;
+    const char *desc = findShortestPathSince(*map, city1, city2, year,
+                                             &status);
+
+    return outputPaths(desc, status);
+}
+
+/** @brief Executes kShortestPaths command.
+ * Prints description of every path in separate line.
+ * @param map [in,out] - double pointer to map,
+ * @param city1 [in]   - pointer to name of first city,
+ * @param city2 [in]   - pointer to name of second city,
+ * @param k [in]       - maximal number of paths.
+ * @return Value @ref SUCCESS if paths were found or cities aren't
+ * connected. Otherwise value @ref ERROR.
+ */
+static int executeKShortestPaths(Map **map, const char *city1,
+                                 const char *city2, unsigned k) {
+    path_status_t status;
+    const char *desc = findAlternativePaths(*map, city1, city2, k, &status);
+
+    return outputPaths(desc, status);
+}
+
+/** @brief Executes paretoPaths command.
+ * Prints description of every Pareto optimal path in separate line.
+ * @param map [in,out] - double pointer to map,
+ * @param city1 [in]   - pointer to name of first city,
+ * @param city2 [in]   - pointer to name of second city.
+ * @return Value @ref SUCCESS if paths were found or cities aren't
+ * connected. Otherwise value @ref ERROR.
+ */
+static int executeParetoPaths(Map **map, const char *city1,
+                              const char *city2) {
+    path_status_t status;
+    const char *desc = findParetoPaths(*map, city1, city2, &status);
+
+    return outputPaths(desc, status);
+}
+
+/** @brief Writes distance to text buffer.
+ * Unreachable distance is written as @p -;- and year of empty path as @p -.
+ * @param text [out]       - pointer to buffer,
+ * @param distance [in]    - pointer to distance.
+ * @return Number of written characters.
+ */
+static size_t printDistance(char *text, const distance_t *distance) {
+    if (!distance->reachable)
+        return (size_t) sprintf(text, ";-;-");
+    if (distance->year == INT_MAX)
+        return (size_t) sprintf(text, ";%u;-", distance->length);
+    return (size_t) sprintf(text, ";%u;%d", distance->length, distance->year);
+}
+
+/** @brief Executes distanceMatrix command.
+ * Prints line for every source, which contains name of source followed by
+ * length and oldest year of shortest path to every target.
+ * @param map [in,out]     - double pointer to map,
+ * @param command [in]     - pointer to command.
+ * @return Value @ref SUCCESS if matrix was computed. Value @ref ERROR if
+ * any city doesn't exist or allocation error occurred.
+ */
+static int executeDistanceMatrix(Map **map, const command_t *command) {
+    size_t sources_num = command->sources_num;
+    size_t targets_num = command->names_num - sources_num;
+    const char *const *names = command->names;
+    distance_t *distances;
+    char *text;
+    size_t text_len, name_len = 0;
+
+    for (size_t i = 0; i < sources_num; i++) {
+        if (strlen(names[i]) > name_len)
+            name_len = strlen(names[i]);
+    }
+    distances = (distance_t *) MEMORY_ALLOC(
+            MEMORY_MAP, sizeof(distance_t) * sources_num * targets_num);
+    text = (char *) MEMORY_ALLOC(MEMORY_MAP, name_len + 1 +
+                                             DISTANCE_TEXT_LENGTH *
+                                             targets_num);
+    if (distances == NULL || text == NULL ||
+        !distanceMatrix(*map, names, sources_num, names + sources_num,
+                        targets_num, distances)) {
+        MEMORY_FREE(MEMORY_MAP, distances);
+        MEMORY_FREE(MEMORY_MAP, text);
         return ERROR;
     }
+
+    for (size_t i = 0; i < sources_num; i++) {
+        text_len = strlen(names[i]);
+        memcpy(text, names[i], text_len);
+        for (size_t j = 0; j < targets_num; j++)
+            text_len += printDistance(text + text_len,
+                                      distances + i * targets_num + j);
+        text[text_len] = '\0';
+        outputLine(text);
+    }
+
+    MEMORY_FREE(MEMORY_MAP, distances);
+    MEMORY_FREE(MEMORY_MAP, text);
+    return SUCCESS;
 }
 
-/** @brief Executes @ref getRouteDescription.
- * Assumes that route number is available through strtok function.
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS or @ref ERROR depending on function result.
+/** @brief Executes reachable command.
+ * Prints line @p city;length for every city reachable within limit,
+ * sorted by length.
+ * @param map [in,out]     - double pointer to map,
+ * @param city [in]        - pointer to name of city,
+ * @param max_length [in]  - maximal length of path.
+ * @return Value @ref SUCCESS if cities were found. Otherwise value
+ * @ref ERROR.
  */
-static int executeGetRouteDescription(Map **map) {
-    char *route_id = strtok(NULL, ";");
-    unsigned route;
-    const char *desc;
+static int executeReachable(Map **map, const char *city,
+                            unsigned max_length) {
+    reach_t *reached;
+    size_t reached_num;
+    char length[16];
 
-    if (route_id == NULL)
-        return ERROR;
-    if (strtok(NULL, ";") != NULL)
+    if (!findReachableCities(*map, city, max_length, &reached, &reached_num))
         return ERROR;
 
-    route = parseStringToUnsigned(route_id);
-    desc = getRouteDescription(*map, route);
+    for (size_t i = 0; i < reached_num; i++) {
+        writeOutput(OUTPUT_RESULT, reached[i].name, strlen(reached[i].name));
+        sprintf(length, ";%u", reached[i].length);
+        outputLine(length);
+    }
 
-    if (desc != NULL) {
-        printf("%s\n", desc);
-        free((void *) desc);
-        return SUCCESS;
-    } else {
-        return ERROR;
+    MEMORY_FREE(MEMORY_PATH, reached);
+    return SUCCESS;
+}
+
+/** @brief Copies city name to text buffer of bulk load block.
+ * @param bulk [in,out]  - pointer to bulk load block,
+ * @param name [in]      - city name,
+ * @param offset [out]   - offset of copied name.
+ * @return Value @p true if name was copied. Value @p false if allocation
+ * error occurred.
+ */
+static bool copyBulkName(bulk_load_t *bulk, const char *name, size_t *offset) {
+    size_t len = strlen(name) + 1;
+    size_t new_capacity = bulk->text_capacity == 0 ? 4096
+                                                   : bulk->text_capacity;
+    char *new_text;
+
+    while (new_capacity < bulk->text_len + len)
+        new_capacity *= 2;
+    if (new_capacity != bulk->text_capacity) {
+        new_text = (char *) MEMORY_REALLOC(MEMORY_PARSER, bulk->text,
+                                           new_capacity);
+        if (new_text == NULL)
+            return false;
+        bulk->text = new_text;
+        bulk->text_capacity = new_capacity;
     }
+
+    memcpy(bulk->text + bulk->text_len, name, len);
+    *offset = bulk->text_len;
+    bulk->text_len += len;
+    return true;
 }
 
-/** @brief Executes @ref newRoute
- * Assumes that description routeId;city1;city2 is available through
- * strtok function.
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS or @ref ERROR depending on function result.
+/** @brief Stores road line read inside bulk load block.
+ * Errors are reported when block ends.
+ * @param bulk [in,out]      - pointer to bulk load block,
+ * @param command [in]       - pointer to parsed road line.
+ * @return Value @ref SUCCESS or @ref CRITICAL_ERROR if allocation error
+ * occurred.
  */
-static int executeNewRoute(Map **map) {
-    char *args[3];
-    unsigned route_id;
+static int storeBulkLine(bulk_load_t *bulk, command_t *command) {
+    bulk_line_t *curr;
 
-    for (int i = 0; i < 3; i++) {
-        args[i] = strtok(NULL, ";");
-        if (args[i] == NULL)
-            return ERROR;
+    if (bulk->lines_num == bulk->lines_capacity) {
+        size_t new_capacity = bulk->lines_capacity == 0
+                              ? 1024 : 2 * bulk->lines_capacity;
+        bulk_line_t *new_lines = (bulk_line_t *) MEMORY_REALLOC(
+                MEMORY_PARSER, bulk->lines,
+                sizeof(bulk_line_t) * new_capacity);
+        if (new_lines == NULL)
+            return CRITICAL_ERROR;
+        bulk->lines = new_lines;
+        bulk->lines_capacity = new_capacity;
     }
-    if (strtok(NULL, ";") != NULL)
-        return ERROR;
-    route_id = parseStringToUnsigned(args[0]);
-    if (newRoute(*map, route_id, args[1], args[2])) {
+
+    curr = &bulk->lines[bulk->lines_num++];
+    curr->line_number = command->line_number;
+    curr->valid = command->valid;
+    if (!command->valid)
         return SUCCESS;
-    } else {
-        return ERROR;
+
+    if (!copyBulkName(bulk, command->cities[0], &curr->city1) ||
+        !copyBulkName(bulk, command->cities[1], &curr->city2))
+        return CRITICAL_ERROR;
+    curr->length = command->length;
+    curr->year = command->year;
+    return SUCCESS;
+}
+
+/** @brief Adds all roads read inside bulk load block using @ref addRoads.
+ * Prints error for every line which wasn't added and clears block.
+ * @param bulk [in,out]  - pointer to bulk load block,
+ * @param map [in,out]   - double pointer to map.
+ * @return Value @ref SUCCESS or @ref CRITICAL_ERROR if allocation error
+ * occurred.
+ */
+static int executeBulkLoad(bulk_load_t *bulk, Map **map) {
+    road_desc_t *roads;
+    bool *added;
+    size_t roads_num = 0;
+
+    roads = (road_desc_t *) MEMORY_ALLOC(MEMORY_PARSER, sizeof(road_desc_t) *
+                                                        (bulk->lines_num + 1));
+    added = (bool *) MEMORY_ALLOC(MEMORY_PARSER,
+                                  sizeof(bool) * (bulk->lines_num + 1));
+    if (roads == NULL || added == NULL) {
+        MEMORY_FREE(MEMORY_PARSER, roads);
+        MEMORY_FREE(MEMORY_PARSER, added);
+        return CRITICAL_ERROR;
+    }
+
+    for (size_t i = 0; i < bulk->lines_num; i++) {
+        if (bulk->lines[i].valid) {
+            roads[roads_num].city1 = bulk->text + bulk->lines[i].city1;
+            roads[roads_num].city2 = bulk->text + bulk->lines[i].city2;
+            roads[roads_num].length = bulk->lines[i].length;
+            roads[roads_num].year = bulk->lines[i].year;
+            roads_num++;
+        }
     }
+
+    if (!addRoads(*map, roads, roads_num, added)) {
+        MEMORY_FREE(MEMORY_PARSER, roads);
+        MEMORY_FREE(MEMORY_PARSER, added);
+        return CRITICAL_ERROR;
+    }
+
+    roads_num = 0;
+    for (size_t i = 0; i < bulk->lines_num; i++) {
+        if (!bulk->lines[i].valid || !added[roads_num++])
+            outputError(bulk->lines[i].line_number);
+    }
+
+    MEMORY_FREE(MEMORY_PARSER, roads);
+    MEMORY_FREE(MEMORY_PARSER, added);
+    bulk->active = false;
+    bulk->text_len = 0;
+    bulk->lines_num = 0;
+    return SUCCESS;
 }
 
-/** @brief Executes @ref extendRoute.
- * Assumes that description routeId;city is available through strtok function.
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS or @ref ERROR depending on function result.
+/** @brief Writes line of statistics to standard output.
+ * @param line [in]          - line of statistics,
+ * @param data [in]          - unused.
  */
-static int executeExtendRoute(Map **map) {
-    char *args[2];
-    unsigned route_id;
+static void outputStatsLine(const char *line, void *data) {
+    (void) data;
+    outputLine(line);
+}
 
-    for (int i = 0; i < 2; i++) {
-        args[i] = strtok(NULL, ";");
-        if (args[i] == NULL)
+/** @brief Writes line of statistics to file.
+ * @param line [in]          - line of statistics,
+ * @param data [in,out]      - pointer to file.
+ */
+static void writeStatsLine(const char *line, void *data) {
+    fprintf((FILE *) data, "%s\n", line);
+}
+
+/** @brief Appends statistics to statistics file.
+ * @param interface [in,out] - pointer to interface,
+ * @param now [in]           - current time in nanoseconds.
+ */
+static void dumpStats(interface_t *interface, uint64_t now) {
+    uint64_t elapsed = (now - interface->start_time) / 1000000u;
+
+    fprintf(interface->stats_file, "# time=%llu.%03llu lines=%d\n",
+            (unsigned long long) (elapsed / 1000),
+            (unsigned long long) (elapsed % 1000), interface->lines_num);
+    reportCommandStats(interface->stats, writeStatsLine, interface->stats_file);
+    reportMemoryStats(writeStatsLine, interface->stats_file);
+    fflush(interface->stats_file);
+    interface->next_dump = now + interface->stats_interval;
+}
+
+/** @brief Logs slow command.
+ * Work of path searches is taken from statistics of current thread, which
+ * weren't recorded yet.
+ * @param interface [in,out] - pointer to interface,
+ * @param command [in]       - pointer to executed command,
+ * @param ok [in]            - flag indicating if command succeeded,
+ * @param duration [in]      - execution time in nanoseconds.
+ */
+static void logSlowCommand(interface_t *interface, const command_t *command,
+                           bool ok, uint64_t duration) {
+    slow_entry_t *entry = addSlowLogEntry(interface->slow_log);
+
+    entry->line_number = command->line_number;
+    entry->ok = ok;
+    entry->duration = duration;
+#ifdef ROADS_SEARCH_STATS
+    entry->searches = search_stats.searches;
+    entry->routes = search_stats.routes;
+#else
+    entry->searches = 0;
+    entry->routes = 0;
+#endif
+    entry->text_len = copyCommandText(command, entry->text,
+                                      SLOW_LOG_TEXT_LENGTH);
+}
+
+/** @brief Executes parsed command.
+ * @param command [in]       - pointer to parsed command,
+ * @param interface [in,out] - pointer to interface.
+ * @return Value @ref SUCCESS if line describes correct command and function
+ * has ended with @ref SUCCESS or line is command or empty. Value
+ * @ref CRITICAL_ERROR if allocation error occurred. Otherwise value
+ * @ref ERROR.
+ */
+static int executeCommand(command_t *command, interface_t *interface) {
+    Map **map = &interface->map;
+    bool result;
+
+    if (command->type == COMMAND_BULK_ROAD)
+        return storeBulkLine(&interface->bulk, command);
+    if (command->type == COMMAND_CRITICAL_ERROR)
+        return CRITICAL_ERROR;
+    if (!command->valid)
+        return ERROR;
+
+    switch (command->type) {
+        case COMMAND_EMPTY:
+            return SUCCESS;
+        case COMMAND_ADD_ROAD:
+            result = addRoad(*map, command->cities[0], command->cities[1],
+                             command->length, command->year);
+            break;
+        case COMMAND_REPAIR_ROAD:
+            result = repairRoad(*map, command->cities[0], command->cities[1],
+                                command->year);
+            break;
+        case COMMAND_GET_ROUTE_DESCRIPTION:
+            return executeGetRouteDescription(map, command->route_id);
+        case COMMAND_NEW_ROUTE:
+            result = newRoute(*map, command->route_id, command->cities[0],
+                              command->cities[1]);
+            break;
+        case COMMAND_EXTEND_ROUTE:
+            result = extendRoute(*map, command->route_id, command->cities[0]);
+            break;
+        case COMMAND_REMOVE_ROAD:
+            result = removeRoad(*map, command->cities[0], command->cities[1]);
+            break;
+        case COMMAND_ANALYZE_REMOVE_ROAD:
+            return executeAnalyzeRemoveRoad(map, command->cities[0],
+                                            command->cities[1]);
+        case COMMAND_REMOVE_ROUTE:
+            result = removeRoute(*map, command->route_id);
+            break;
+        case COMMAND_SHORTEST_PATH:
+            return executeShortestPath(map, command->cities[0],
+                                       command->cities[1]);
+        case COMMAND_SHORTEST_PATH_SINCE:
+            return executeShortestPathSince(map, command->cities[0],
+                                            command->cities[1], command->year);
+        case COMMAND_OLDEST_ROADS:
+            return executeOldestRoads(map, command->route_id);
+        case COMMAND_ROADS_OLDER_THAN:
+            return executeRoadsOlderThan(map, command->year);
+        case COMMAND_ROUTE_OLDEST_ROAD:
+            return executeRouteOldestRoad(map, command->route_id);
+        case COMMAND_DISTANCE_MATRIX:
+            return executeDistanceMatrix(map, command);
+        case COMMAND_REACHABLE:
+            return executeReachable(map, command->cities[0], command->length);
+        case COMMAND_K_SHORTEST_PATHS:
+            return executeKShortestPaths(map, command->cities[0],
+                                         command->cities[1], command->route_id);
+        case COMMAND_PARETO_PATHS:
+            return executeParetoPaths(map, command->cities[0],
+                                      command->cities[1]);
+        case COMMAND_CREATE_ROUTE:
+            result = createRoute(map, command->route_id, command->roads,
+                                 command->roads_num);
+            break;
+        case COMMAND_BEGIN_BULK_LOAD:
+            interface->bulk.active = true;
+            return SUCCESS;
+        case COMMAND_END_BULK_LOAD:
+            return executeBulkLoad(&interface->bulk, map);
+        case COMMAND_FLUSH:
+            flushOutput();
+            if (interface->slow_log != NULL)
+                flushSlowLog(interface->slow_log);
+            return SUCCESS;
+        case COMMAND_STATS:
+            reportCommandStats(interface->stats, outputStatsLine, NULL);
+            reportMemoryStats(outputStatsLine, NULL);
+            return SUCCESS;
+        default:
             return ERROR;
     }
-    if (strtok(NULL, ";") != NULL)
-        return ERROR;
+    return result ? SUCCESS : ERROR;
+}
 
-    route_id = parseStringToUnsigned(args[0]);
+/** @brief Executes command and reports its result.
+ * Measures execution time of command.
+ * @param command [in]       - pointer to parsed command,
+ * @param interface [in,out] - pointer to interface.
+ * @return Value @p false if critical error occurred. Otherwise value @p true.
+ */
+static bool processCommand(command_t *command, interface_t *interface) {
+    uint64_t start, end;
+    int ret_val;
 
-    if (extendRoute(*map, route_id, args[1])) {
-        return SUCCESS;
-    } else {
-        return ERROR;
+    interface->lines_num = command->line_number;
+    if (command->type == COMMAND_EMPTY)
+        return true;
+
+    start = getTimeNs();
+    ret_val = executeCommand(command, interface);
+    end = getTimeNs();
+
+    if (ret_val == CRITICAL_ERROR)
+        return false;
+    if (ret_val == ERROR)
+        outputError(command->line_number);
+
+    if (interface->slow_log != NULL &&
+        end - start >= interface->slow_log->threshold)
+        logSlowCommand(interface, command, ret_val == SUCCESS, end - start);
+    recordCommand(interface->stats, command->type, ret_val == SUCCESS,
+                  end - start);
+    if (interface->stats_file != NULL && end >= interface->next_dump)
+        dumpStats(interface, end);
+    return true;
+}
+
+/** @brief Reads, parses and executes lines in one thread.
+ * Used if parser thread can't be created.
+ * @param reader [in,out]    - pointer to input reader,
+ * @param interface [in,out] - pointer to interface.
+ * @return Value @p false if critical error occurred. Otherwise value @p true.
+ */
+static bool runSequentially(line_reader_t *reader, interface_t *interface) {
+    command_t command;
+    bool bulk_active = false, result = true;
+    int line_number = 0;
+    int read_result;
+
+    initCommand(&command);
+    while ((read_result = readLine(reader, &command)) == 1) {
+        command.line_number = ++line_number;
+        parseCommand(&command, &bulk_active);
+        if (!processCommand(&command, interface)) {
+            result = false;
+            break;
+        }
     }
+    clearCommand(&command);
+    return result && read_result == 0;
 }
 
-/** @brief Executes @ref removeRoad.
- * Assumes that description city1;city2 is available through strtok function.
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS or @ref ERROR depending on function result.
+/** @brief Executes commands parsed by parser thread.
+ * @param queue [in,out]     - pointer to queue of commands,
+ * @param interface [in,out] - pointer to interface.
+ * @return Value @p false if critical error occurred. Otherwise value @p true.
  */
-static int executeRemoveRoad(Map **map) {
-    char *args[2];
+static bool runExecutor(command_queue_t *queue, interface_t *interface) {
+    command_t *command;
 
-    for (int i = 0; i < 2; i++) {
-        args[i] = strtok(NULL, ";");
-        if (args[i] == NULL)
-            return ERROR;
+    while (true) {
+        command = takeCommand(queue);
+        if (command->type == COMMAND_END_OF_INPUT) {
+            releaseCommand(queue);
+            return true;
+        }
+        if (!processCommand(command, interface)) {
+            releaseCommand(queue);
+            return false;
+        }
+        releaseCommand(queue);
     }
-    if (strtok(NULL, ";") != NULL)
-        return ERROR;
-    if (removeRoad(*map, args[0], args[1])) {
-        return SUCCESS;
-    } else {
-        return ERROR;
+}
+
+/** @brief Reads whole file into memory.
+ * @param path [in]          - path of file,
+ * @param len [out]          - length of file.
+ * @return Pointer to content of file or NULL if file can't be read or
+ * allocation error occurred.
+ */
+static char *loadFile(const char *path, size_t *len) {
+    FILE *file = fopen(path, "rb");
+    size_t capacity = READ_BUFFER_SIZE, read_len;
+    char *content = NULL, *new_content;
+
+    if (file == NULL)
+        return NULL;
+
+    *len = 0;
+    while (true) {
+        new_content = (char *) MEMORY_REALLOC(MEMORY_PARSER, content,
+                                              capacity);
+        if (new_content == NULL) {
+            MEMORY_FREE(MEMORY_PARSER, content);
+            content = NULL;
+            break;
+        }
+        content = new_content;
+        read_len = fread(content + *len, 1, capacity - *len, file);
+        *len += read_len;
+        if (*len < capacity) {
+            if (ferror(file)) {
+                MEMORY_FREE(MEMORY_PARSER, content);
+                content = NULL;
+            }
+            break;
+        }
+        capacity *= 2;
     }
+
+    fclose(file);
+    return content;
 }
 
-/** @brief Executes @ref removeRoute.
- * Assumes that route number is available through strtok function.
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS or @ref ERROR depending on function result.
+/** @brief Replays commands once on new map.
+ * Reader has no file descriptor, so it ends with its buffer.
+ * @param reader [in,out]    - pointer to reader of loaded file,
+ * @param interface [in,out] - pointer to interface,
+ * @param time [out]         - times of replay.
+ * @return Value @p false if critical error occurred. Otherwise value @p true.
  */
-static int executeRemoveRoute(Map **map) {
-    char *arg = strtok(NULL, ";");
-    unsigned route_id;
+static bool replayCommands(line_reader_t *reader, interface_t *interface,
+                           replay_time_t *time) {
+    command_t command;
+    bool bulk_active = false, result = true;
+    int line_number = 0;
+    int read_result;
+    uint64_t start, parsed, executed;
 
-    if (arg == NULL)
-        return ERROR;
-    if (strtok(NULL, ";") != NULL)
-        return ERROR;
+    time->total = getTimeNs();
+    time->parse = 0;
+    time->engine = 0;
+    reader->pos = 0;
+    interface->map = newMap();
+    if (interface->map == NULL)
+        return false;
 
-    route_id = parseStringToUnsigned(arg);
+    initCommand(&command);
+    while (true) {
+        start = getTimeNs();
+        read_result = readLine(reader, &command);
+        if (read_result != 1)
+            break;
+        command.line_number = ++line_number;
+        parseCommand(&command, &bulk_active);
+        parsed = getTimeNs();
+        result = processCommand(&command, interface);
+        executed = getTimeNs();
 
-    if (removeRoute(*map, route_id)) {
-        return SUCCESS;
-    } else {
-        return ERROR;
+        time->parse += parsed - start;
+        time->engine += executed - parsed;
+        if (!result)
+            break;
     }
+    clearCommand(&command);
+
+    if (result && interface->bulk.active) {
+        start = getTimeNs();
+        result = executeBulkLoad(&interface->bulk, &interface->map) == SUCCESS;
+        time->engine += getTimeNs() - start;
+    }
+    time->total = getTimeNs() - time->total;
+
+    deleteMap(interface->map);
+    interface->map = NULL;
+    interface->bulk.active = false;
+    interface->bulk.text_len = 0;
+    interface->bulk.lines_num = 0;
+    return result && read_result == 0;
 }
 
-/** @brief Parses text line and executes requested function.
- * If line is empty or is a comment does nothing.
- * @param line [in]    - pointer to text line,
- * @param map [in,out] - double pointer to map.
- * @return Value @ref SUCCESS if line describes correct command and function
- * has ended with @ref SUCCESS or line is command or empty. Otherwise value
- * @ref ERROR.
+/** @brief Writes line with times of replay to standard output.
+ * @param name [in]          - name of line,
+ * @param time [in]          - times of replay.
  */
-static int parseAndExecuteTextLine(char *line, Map **map) {
-    char *command;
-    unsigned route_id;
+static void outputReplayTime(const char *name, const replay_time_t *time) {
+    char line[256];
 
-    if (*line == '#' || *line == '\n')
-        return SUCCESS;
+    snprintf(line, sizeof(line), "%s total_ms=%.3f parse_ms=%.3f "
+                                 "engine_ms=%.3f", name,
+             (double) time->total / 1e6, (double) time->parse / 1e6,
+             (double) time->engine / 1e6);
+    outputLine(line);
+}
 
-    line = strtok(line, "\n");
+/** @brief Compares replays by total time.
+ * @param a [in]             - pointer to first replay time,
+ * @param b [in]             - pointer to second replay time.
+ * @return Negative, zero or positive number like strcmp.
+ */
+static int compareReplayTimes(const void *a, const void *b) {
+    uint64_t time1 = ((const replay_time_t *) a)->total;
+    uint64_t time2 = ((const replay_time_t *) b)->total;
 
-    if (checkIfSemicolonLast(line))
-        return ERROR;
+    return (time1 > time2) - (time1 < time2);
+}
 
-    command = strtok(line, ";");
-    if (command == NULL)
-        return ERROR;
-    if (strcmp(command, "addRoad") == 0)
-        return executeAddRoad(map);
-    if (strcmp(command, "repairRoad") == 0)
-        return executeRepairRoad(map);
-    if (strcmp(command, "getRouteDescription") == 0)
-        return executeGetRouteDescription(map);
-    if (strcmp(command, "newRoute") == 0)
-        return executeNewRoute(map);
-    if (strcmp(command, "extendRoute") == 0)
-        return executeExtendRoute(map);
-    if (strcmp(command, "removeRoad") == 0)
-        return executeRemoveRoad(map);
-    if (strcmp(command, "removeRoute") == 0)
-        return executeRemoveRoute(map);
-    route_id = parseStringToUnsigned(command);
-    if (route_id > 0 && route_id < 1000)
-        return executeCreateRoute(map, route_id);
-    return ERROR;
+/** @brief Computes median of sorted replay times.
+ * If number of replays is even, median is average of two middle replays.
+ * @param times [in]         - array of replay times sorted by total time,
+ * @param times_num [in]     - number of replays, at least 1,
+ * @param median [out]       - median times.
+ */
+static void getMedianReplayTime(const replay_time_t *times, unsigned times_num,
+                                replay_time_t *median) {
+    const replay_time_t *upper = &times[times_num / 2];
+    const replay_time_t *lower = &times[(times_num - 1) / 2];
+
+    median->total = (lower->total + upper->total) / 2;
+    median->parse = (lower->parse + upper->parse) / 2;
+    median->engine = (lower->engine + upper->engine) / 2;
 }
 
-/** @brief Runs text interface.
- * @return Value @p 0.
+/** @brief Replays file of commands and prints times.
+ * Every replay starts with empty map. Results and errors of commands are
+ * discarded. Statistics of commands are collected only in measured
+ * replays, so times of commands are summed over them.
+ * @param options [in]       - pointer to options of interface,
+ * @param interface [in,out] - pointer to interface.
+ * @return Value @p 0 or @p 1 if file can't be read or critical error
+ * occurred.
  */
-int runMapInterface() {
-    size_t size;
-    int line_counter = 0;
-    int ret_val;
-    char *line = NULL;
+static int runReplay(const interface_options_t *options,
+                     interface_t *interface) {
+    line_reader_t reader = {-1, NULL, 0, 0};
+    replay_time_t *times, median;
+    command_stats_t *measured_stats = interface->stats;
+    command_stats_t *warmup_stats = createCommandStats();
+    unsigned runs = options->warmup + options->repeat;
+    char line[128];
+    bool result = true;
+
+    times = (replay_time_t *) malloc(sizeof(replay_time_t) * runs);
+    if (times == NULL || warmup_stats == NULL) {
+        free(times);
+        deleteCommandStats(warmup_stats);
+        return 1;
+    }
+    reader.buffer = loadFile(options->replay, &reader.len);
+    if (reader.buffer == NULL) {
+        perror(options->replay);
+        free(times);
+        deleteCommandStats(warmup_stats);
+        return 1;
+    }
+
+    discardOutput(true);
+    for (unsigned i = 0; i < runs && result; i++) {
+        interface->stats = i < options->warmup ? warmup_stats : measured_stats;
+        result = replayCommands(&reader, interface, &times[i]);
+    }
+    interface->stats = measured_stats;
+    discardOutput(false);
 
-    Map *map = newMap();
+    if (result) {
+        snprintf(line, sizeof(line), "# replay lines=%d warmup=%u repeat=%u",
+                 interface->lines_num, options->warmup, options->repeat);
+        outputLine(line);
+        for (unsigned i = options->warmup; i < runs; i++) {
+            snprintf(line, sizeof(line), "run=%u", i - options->warmup + 1);
+            outputReplayTime(line, &times[i]);
+        }
+        qsort(times + options->warmup, options->repeat, sizeof(replay_time_t),
+              compareReplayTimes);
+        outputReplayTime("min", &times[options->warmup]);
+        getMedianReplayTime(times + options->warmup, options->repeat, &median);
+        outputReplayTime("median", &median);
+        reportCommandStats(measured_stats, outputStatsLine, NULL);
+        reportMemoryStats(outputStatsLine, NULL);
+    } else {
+        fprintf(stderr, "replay failed\n");
+    }
+
+    MEMORY_FREE(MEMORY_PARSER, reader.buffer);
+    free(times);
+    deleteCommandStats(warmup_stats);
+    return result ? 0 : 1;
+}
+
+/** @brief Runs text interface.
+ * @param options [in]       - pointer to options of interface.
+ * @return Value @p 0 or @p 1 if replay failed.
+ */
+int runMapInterface(const interface_options_t *options) {
+    line_reader_t reader = {STDIN_FILENO, NULL, 0, 0};
+    interface_t interface = {NULL, {false, NULL, 0, 0, NULL, 0, 0}, NULL,
+                             NULL, NULL, 0, 0, 0, 0};
+    command_queue_t *queue = NULL;
+    parser_args_t args;
+    pthread_t parser;
+    bool result = false;
+    int exit_code = 0;
 
-    if (map == NULL)
-        return 0;
+    initOutput();
+    interface.map = options->replay == NULL ? newMap() : NULL;
+    interface.stats = createCommandStats();
+    reader.buffer = (char *) MEMORY_ALLOC(MEMORY_PARSER, READ_BUFFER_SIZE);
+    if ((interface.map == NULL && options->replay == NULL) ||
+        interface.stats == NULL || reader.buffer == NULL)
+        goto cleanup;
 
-    while (getline(&line, &size, stdin) != -1) {
-        ret_val = parseAndExecuteTextLine(line, &map);
+    interface.start_time = getTimeNs();
+    if (options->stats_file != NULL) {
+        interface.stats_file = fopen(options->stats_file, "w");
+        if (interface.stats_file == NULL) {
+            perror(options->stats_file);
+            goto cleanup;
+        }
+        interface.stats_interval = (uint64_t) options->stats_interval *
+                                   1000000000u;
+        interface.next_dump = interface.start_time + interface.stats_interval;
+    }
+    if (options->slow_log != NULL) {
+        interface.slow_log = createSlowLog(options->slow_log,
+                                           (uint64_t) options->slow_threshold *
+                                           1000u);
+        if (interface.slow_log == NULL) {
+            perror(options->slow_log);
+            goto cleanup;
+        }
+    }
 
-        line_counter++;
+    if (options->replay != NULL) {
+        exit_code = runReplay(options, &interface);
+        goto cleanup;
+    }
 
-        if (ret_val == ERROR) {
-            fprintf(stderr, "ERROR %d\n", line_counter);
-        } else if (ret_val == CRITICAL_ERROR) {
-            deleteMap(map);
-            free(line);
-            return 0;
+    queue = createCommandQueue(QUEUE_CAPACITY);
+    args.queue = queue;
+    args.reader = &reader;
+    if (queue != NULL && pthread_create(&parser, NULL, runParser, &args) == 0) {
+        result = runExecutor(queue, &interface);
+        if (!result) {
+            // Parser may wait for input, which won't be used.
+            closeCommandQueue(queue);
+            pthread_cancel(parser);
         }
+        pthread_join(parser, NULL);
+    } else {
+        result = runSequentially(&reader, &interface);
     }
 
-    free(line);
-    deleteMap(map);
+    // Block not closed before end of input is added anyway.
+    if (interface.bulk.active && result)
+        executeBulkLoad(&interface.bulk, &interface.map);
+
+    if (interface.stats_file != NULL)
+        dumpStats(&interface, getTimeNs());
+
+cleanup:
+    if (interface.stats_file != NULL)
+        fclose(interface.stats_file);
+    deleteSlowLog(interface.slow_log);
+    deleteCommandQueue(queue);
+    MEMORY_FREE(MEMORY_PARSER, reader.buffer);
+    MEMORY_FREE(MEMORY_PARSER, interface.bulk.text);
+    MEMORY_FREE(MEMORY_PARSER, interface.bulk.lines);
+    deleteCommandStats(interface.stats);
+    deleteMap(interface.map);
+    flushOutput();
 
-    return 0;
+    return exit_code;
 }
@@ -8,6 +8,20 @@
 #ifndef ROADS_TEXT_INTERFACE_H
 #define ROADS_TEXT_INTERFACE_H
 
-int runMapInterface();
+/**
+ * Structure representing options of text interface.
+ */
+typedef struct interface_options {
+    const char *stats_file;     /**< File with periodic statistics or NULL. */
+    unsigned stats_interval;    /**< Interval of statistics dumps in seconds. */
+    const char *slow_log;       /**< File with log of slow commands or NULL. */
+    unsigned slow_threshold;    /**< Minimal execution time of logged command
+                                     in microseconds. */
+    const char *replay;         /**< File with replayed commands or NULL. */
+    unsigned repeat;            /**< Number of measured replays. */
+    unsigned warmup;            /**< Number of replays before measured ones. */
+} interface_options_t;
+
+int runMapInterface(const interface_options_t *options);
 
 #endif //ROADS_TEXT_INTERFACE_H
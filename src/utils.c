@@ -8,6 +8,7 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -34,6 +35,28 @@ bool cityNameEq(void *name1, void *name2) {
     return strcmp((const char *) name1, (const char *) name2) == 0;
 }
 
+/** @brief Utility function compares handles of interned city names.
+ * Handles are ordered by address, which is stable for whole life of map.
+ * Used only by avlMaps.
+ * @param handle1 [in] - first handle,
+ * @param handle2 [in] - second handle.
+ * @return Value @p true if @p handle1 doesn't come after @p handle2.
+ * Otherwise value @p false.
+ */
+bool cityHandleCmp(void *handle1, void *handle2) {
+    return (uintptr_t) handle1 <= (uintptr_t) handle2;
+}
+
+/** @brief Utility function checks if handles of interned city names are equal.
+ * Used only by avlMaps.
+ * @param handle1 [in] - first handle,
+ * @param handle2 [in] - second handle.
+ * @return Value @p true if handles are the same. Otherwise value @p false.
+ */
+bool cityHandleEq(void *handle1, void *handle2) {
+    return handle1 == handle2;
+}
+
 /** @brief Do nothing, but can be used to print city name. */
 void printCityName() {}
 
@@ -12,6 +12,10 @@ bool cityNameCmp(void *name1, void *name2);
 
 bool cityNameEq(void *name1, void *name2);
 
+bool cityHandleCmp(void *handle1, void *handle2);
+
+bool cityHandleEq(void *handle1, void *handle2);
+
 void printCityName();
 
 bool checkCityName(const char *name);